@@ -0,0 +1,87 @@
+/**************************************************************************************************
+* aligned_allocator.hpp: Innehåller klassmallen aligned_allocator, som används för att allokera
+*                        minne med en given justering (alignment), exempelvis för vektorer
+*                        innehållande träningsdata som skall läsas via SIMD-instruktioner.
+**************************************************************************************************/
+#ifndef ALIGNED_ALLOCATOR_HPP_
+#define ALIGNED_ALLOCATOR_HPP_
+
+/* Inkluderingsdirektiv: */
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+/**************************************************************************************************
+* aligned_allocator: Allokator som placerar allokerat minne på adresser som är jämnt delbara med
+*                    angiven justering Alignment, som default 64 byte. Därmed börjar varje
+*                    vektor på en ny cacheline, vilket möjliggör justerade SIMD-läsningar samt
+*                    förhindrar att data delar cacheline med annan data.
+*
+*                    Minnet hämtas från en minnesresurs (std::pmr), som default
+*                    std::pmr::get_default_resource(), exempelvis en arena eller en resurs som
+*                    allokerar stora sidor. Likt std::pmr::polymorphic_allocator följer
+*                    minnesresursen inte med vid tilldelning, vilket gör att en vektor alltid
+*                    behåller sin resurs. Vid förflyttning mellan vektorer med samma resurs
+*                    förflyttas minnet utan att något kopieras.
+**************************************************************************************************/
+template <typename T, std::size_t Alignment = 64>
+class aligned_allocator
+{
+   /* Medlemmar: */
+   std::pmr::memory_resource* m_resource; /* Minnesresurs som minnet allokeras från. */
+
+   template <typename U, std::size_t A>
+   friend class aligned_allocator;
+
+public:
+   using value_type = T;
+
+   template <typename U>
+   struct rebind { using other = aligned_allocator<U, Alignment>; };
+
+   aligned_allocator(void) noexcept
+      : m_resource(std::pmr::get_default_resource()) { }
+
+   aligned_allocator(std::pmr::memory_resource* resource) noexcept
+      : m_resource(resource) { }
+
+   template <typename U>
+   aligned_allocator(const aligned_allocator<U, Alignment>& other) noexcept
+      : m_resource(other.m_resource) { }
+
+   std::pmr::memory_resource* resource(void) const noexcept { return m_resource; }
+
+   T* allocate(const std::size_t num_elements)
+   {
+      return static_cast<T*>(m_resource->allocate(num_elements * sizeof(T), Alignment));
+   }
+
+   void deallocate(T* data, const std::size_t num_elements)
+   {
+      m_resource->deallocate(data, num_elements * sizeof(T), Alignment);
+      return;
+   }
+
+   aligned_allocator select_on_container_copy_construction(void) const noexcept
+   {
+      return aligned_allocator();
+   }
+
+   template <typename U>
+   bool operator == (const aligned_allocator<U, Alignment>& other) const noexcept
+   {
+      return m_resource == other.m_resource || m_resource->is_equal(*other.m_resource);
+   }
+
+   template <typename U>
+   bool operator != (const aligned_allocator<U, Alignment>& other) const noexcept
+   {
+      return !(*this == other);
+   }
+};
+
+/* Vektor med minne justerat efter cacheline: */
+template <typename T>
+using aligned_vector = std::vector<T, aligned_allocator<T>>;
+
+#endif /* ALIGNED_ALLOCATOR_HPP_ */
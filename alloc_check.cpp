@@ -0,0 +1,163 @@
+/**************************************************************************************************
+* alloc_check.cpp: Kontrollerar att träning samt prediktion med klassen lin_reg inte allokerar
+*                  något minne efter en inledande uppvärmning, då samtliga buffertar har
+*                  allokerats. Den globala operatorn new ersätts av en version som räknar
+*                  antalet allokeringar, varefter antalet allokeringar under train samt
+*                  predict_batch räknas för samtliga lösningsmetoder, med och utan
+*                  minibatcher, validering, standardisering samt flera trådar. Träningsdatan allokeras via en
+*                  arena (std::pmr::monotonic_buffer_resource) utan möjlighet att växa, vilket
+*                  även kontrollerar att träningsdatan hämtas från angiven minnesresurs.
+*
+*                  I Windows, kompilera koden och skapa en körbar fil alloc_check.exe med
+*                  följande kommando:
+*                  $ g++ alloc_check.cpp lin_reg.cpp binary_data.cpp mapped_file.cpp text_parser.cpp regression_stats.cpp kernels.cpp thread_pool.cpp shuffler.cpp optimizer.cpp model_snapshot.cpp prediction_writer.cpp -o alloc_check.exe -Wall -std=c++17
+*
+*                  Kör sedan programmet med följande kommando:
+*                  $ alloc_check.exe
+**************************************************************************************************/
+#include "lin_reg.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+/* Antalet anrop av den globala operatorn new: */
+static std::atomic<std::size_t> num_allocations{ 0 };
+
+/**************************************************************************************************
+* operator new: Allokerar minne via std::malloc och räknar antalet allokeringar.
+*
+*               - size: Antalet byte som skall allokeras.
+**************************************************************************************************/
+void* operator new(std::size_t size)
+{
+   num_allocations++;
+   if (auto* data = std::malloc(size > 0 ? size : 1)) return data;
+   throw std::bad_alloc();
+}
+
+/**************************************************************************************************
+* operator delete: Frigör minne allokerat via operator new ovan.
+*
+*                  - data: Pekare till det minne som skall frigöras.
+**************************************************************************************************/
+void operator delete(void* data) noexcept
+{
+   std::free(data);
+   return;
+}
+
+/**************************************************************************************************
+* operator delete: Frigör minne allokerat via operator new ovan, där storleken ignoreras.
+*
+*                  - data: Pekare till det minne som skall frigöras.
+**************************************************************************************************/
+void operator delete(void* data, std::size_t) noexcept
+{
+   std::free(data);
+   return;
+}
+
+/**************************************************************************************************
+* count_allocations: Returnerar antalet allokeringar som sker vid anrop av angiven funktion.
+*
+*                    - function: Den funktion vars allokeringar skall räknas.
+**************************************************************************************************/
+template <typename Function>
+static std::size_t count_allocations(Function&& function)
+{
+   const std::size_t before = num_allocations;
+   function();
+   return num_allocations - before;
+}
+
+/**************************************************************************************************
+* check: Tränar angiven modell en gång för uppvärmning och räknar därefter antalet allokeringar
+*        under upprepad träning samt prediktion. Ifall någon allokering sker skrivs antalet ut
+*        i terminalen och false returneras.
+*
+*        - name  : Namnet på aktuell konfiguration.
+*        - model : Regressionsmodellen som skall kontrolleras.
+*        - input : Insignaler för prediktion.
+*        - output: Vektor där predikterade utsignaler lagras.
+**************************************************************************************************/
+static bool check(const char* name,
+                  lin_reg& model,
+                  const std::vector<double>& input,
+                  std::vector<double>& output)
+{
+   model.train();
+   model.predict_batch(input, output);
+
+   const auto train = count_allocations([&](void) { model.train(); });
+   const auto predict = count_allocations([&](void)
+   {
+      model.predict_batch(input.data(), output.data(), input.size());
+      model.predict_batch(input, output);
+   });
+
+   if (train == 0 && predict == 0) return true;
+   std::cerr << name << ": " << train << " allocations in train, "
+             << predict << " in predict_batch!\n";
+   return false;
+}
+
+/**************************************************************************************************
+* main: Genererar träningsdata enligt formeln y = -2.5x + 10 och kontrollerar att träning samt
+*       prediktion sker utan allokering för samtliga kombinationer av minibatcher, validering,
+*       standardisering, adaptiv justering, tidigt avbrott samt två trådar, samt för den exakta
+*       minstakvadratlösningen med en respektive två trådar. Träningsdatan för varje modell läggs i en arena i en
+*       förallokerad buffert, där std::pmr::null_memory_resource medför att ett undantag
+*       kastas ifall arenan inte räcker till. Ifall samtliga kontroller lyckas returneras 0,
+*       annars 1.
+**************************************************************************************************/
+int main(void)
+{
+   const std::size_t num_sets = 10000;
+   std::vector<double> input(num_sets), output(num_sets);
+   std::vector<char> buffer(4 * num_sets * sizeof(double));
+   auto ok = true;
+
+   for (std::size_t i = 0; i < num_sets; ++i)
+   {
+      input[i] = static_cast<double>(i % 200) * 0.05 - 5;
+      output[i] = -2.5 * input[i] + 10;
+   }
+
+   auto configure = [&](lin_reg& model, const std::size_t config)
+   {
+      model.set_seed(1);
+      if (config & 1) model.set_batch_size(64);
+      if (config & 2) model.set_validation_split(0.2);
+      if (config & 4) model.set_standardization(true);
+      if (config & 8) model.set_optimizer(optimizer_mode::adam);
+      if (config & 16) model.set_early_stopping(1e-9);
+      if (config & 32) model.set_num_threads(2);
+      return;
+   };
+
+   for (std::size_t config = 0; config < 66; ++config)
+   {
+      std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), 
+                                                std::pmr::null_memory_resource());
+      lin_reg model(5, 0.001, &arena);
+      const auto name = (config < 64 ? "sgd/config:" : "closed_form/config:") + std::to_string(config);
+
+      if (config < 64)
+      {
+         configure(model, config);
+      }
+      else
+      {
+         model.set_solver(lin_reg::solver_mode::closed_form);
+         model.set_num_threads(config - 62);
+      }
+
+      model.set_training_data(input, output);
+      ok = check(name.c_str(), model, input, output) && ok;
+   }
+
+   std::cout << (ok ? "No allocations after warm-up!\n" : "Allocation checks failed!\n");
+   return ok ? 0 : 1;
+}
@@ -0,0 +1,1238 @@
+/**************************************************************************************************
+* basic_lin_reg.hpp: Innehåller klassmallen basic_lin_reg för implementering av
+*                    maskininlärningsmodeller som baseras på linjär regression, där typen för
+*                    flyttalen, antalet insignaler samt lagringsordningen för träningsdatan
+*                    anges vid kompilering.
+**************************************************************************************************/
+#ifndef BASIC_LIN_REG_HPP_
+#define BASIC_LIN_REG_HPP_
+
+/* Inkluderingsdirektiv: */
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory_resource>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "aligned_allocator.hpp"
+#include "binary_data.hpp"
+#include "feature_matrix.hpp"
+#include "instrumentation.hpp"
+#include "kernels.hpp"
+#include "load_stats.hpp"
+#include "mapped_file.hpp"
+#include "shuffler.hpp"
+#include "text_parser.hpp"
+
+/* Antal insignaler som anger att antalet avgörs vid körning: */
+static constexpr std::size_t dynamic_features = 0;
+
+/**************************************************************************************************
+* basic_lin_reg: Klassmall för implementering av maskininlärningsmodeller som baseras på linjär
+*                regression, där T utgör typen för flyttalen (float eller double) och N utgör
+*                antalet insignaler per träningsuppsättning. Vid N = dynamic_features avgörs
+*                antalet insignaler i stället vid körning, antingen via konstruktorn eller
+*                utifrån den första träningsuppsättning som läses in.
+*
+*                Vid ett fast antal insignaler är samtliga loopar över insignalerna av känd
+*                längd, vilket gör att kompilatorn kan rulla ut skalärprodukten helt. Vikterna
+*                lagras då i en array som kopieras till lokala variabler under träning samt
+*                prediktion, så att parametrarna kan hållas i register. Med T = float halveras
+*                minnesåtgången samt antalet lästa byte per träningsuppsättning, samtidigt som
+*                dubbelt så många element ryms i varje SIMD-register.
+*
+*                Insignalerna lagras i en sammanhängande matris (feature_matrix) justerad efter
+*                cacheline, vars minne hämtas från en minnesresurs (std::pmr) som kan anges vid
+*                konstruktion. Träning sker via stokastisk gradientnedstigning, antingen per
+*                träningsuppsättning eller via minibatcher av sammanhängande
+*                träningsuppsättningar, där gradienterna ackumuleras i en cacheline av
+*                oberoende ackumulatorer per parameter, vilket möjliggör autovektorisering.
+*
+*                Layout anger matrisens lagringsordning, radvis som default. Kolumnvis lagring
+*                (matrix_layout::column_major) påverkar enbart hur träningsdatan lagras, där
+*                binära filer kopieras kolumn för kolumn utan att flätas samman. Någon
+*                kolumnvis beräkningskärna finns inte, utan vid träning samlas varje
+*                träningsuppsättnings insignaler ihop i en buffert före skalärprodukten,
+*                vilket gör träningen något långsammare än vid radvis lagring.
+*
+*                Träningslooparna train_single samt train_mini_batch finns även i form av
+*                mallar, där justeringen av parametrarna samt åtgärder före och efter varje
+*                epok anges av anroparen. Därmed kan härledda klasser, exempelvis lin_reg som
+*                härleds från basic_lin_reg<double, 1>, lägga till adaptiva metoder för
+*                justering, tidigt avbrott samt validering utan att looparna dupliceras.
+*
+*                Ifall makrot LIN_REG_INSTRUMENTATION definieras vid kompilering samlas
+*                statistik för tidsåtgång samt antalet inlästa och predikterade
+*                träningsuppsättningar in, vilken kan läsas via training_statistics.
+*
+*                Klassens kopieringskonstruktor samt tilldelningsoperator är raderade, medan
+*                förflyttningskonstruktorn samt tilldelningsoperatorn för förflyttning är
+*                implementerade.
+**************************************************************************************************/
+template <typename T, std::size_t N, matrix_layout Layout = matrix_layout::row_major>
+class basic_lin_reg
+{
+   static_assert(std::is_floating_point<T>::value, "basic_lin_reg requires a floating point type");
+
+public:
+   using value_type = T;
+
+protected:
+   /* Typ för vikterna, en array vid fast antal insignaler: */
+   using weight_storage = typename std::conditional<N == dynamic_features,
+                                                    aligned_vector<T>,
+                                                    std::array<T, N>>::type;
+
+   /* Statiska konstanter: */
+   static constexpr std::size_t num_lanes = 64 / sizeof(T); /* Ackumulatorer per parameter. */
+   static constexpr std::size_t binary_block_rows = 4096;   /* Rader per block vid binär inläsning. */
+
+   /* Medlemmar: */
+   feature_matrix<T, Layout> m_train_in;    /* Insignaler för träningsuppsättningar. */
+   aligned_vector<T> m_train_out;           /* Utdata för träningsuppsättningarna. */
+   std::vector<std::size_t> m_train_order;  /* Ordningsföljd för träningsuppsättningarna. */
+   std::vector<std::size_t> m_batch_order;  /* Ordningsföljd för minibatcher vid träning. */
+   weight_storage m_weights{};              /* Vikter (en per insignal). */
+   aligned_vector<T> m_gradient;            /* Ackumulatorer för gradienter vid minibatcher. */
+   std::vector<double> m_row;               /* Buffert för en rad vid inläsning. */
+   aligned_vector<T> m_gather;              /* Buffert för en rad vid kolumnvis lagring. */
+   T m_bias = 0;                            /* Vilovärde (m-värde). */
+   T m_learning_rate = 0;                   /* Lärhastighet (avgör justeringsgrad vid fel). */
+   std::size_t m_num_epochs = 0;            /* Antalet träningsomgångar. */
+   std::size_t m_batch_size = 1;            /* Antalet träningsuppsättningar per minibatch. */
+   std::size_t m_num_features = N;          /* Antalet insignaler vid dynamiskt antal. */
+   std::size_t m_data_version = 0;          /* Räknare som ökas när träningsdatan ändras. */
+   shuffler m_shuffler;                     /* Randomiserar träningsuppsättningarnas ordning. */
+   mutable instrumentation m_instrumentation; /* Statistik för tidsåtgång samt genomströmning. */
+
+   /**********************************************************************************************
+   * dot: Returnerar skalärprodukten av angivna arrayer med num_features() element. Vid fast
+   *      antal insignaler är loopens längd känd vid kompilering och rullas ut. Vid dynamiskt
+   *      antal används beräkningskärnan dot_product för double, annars fyra oberoende
+   *      ackumulatorer.
+   *
+   *      - a: Den första arrayen, exempelvis insignalerna för en träningsuppsättning.
+   *      - b: Den andra arrayen, exempelvis modellens vikter.
+   **********************************************************************************************/
+   T dot(const T* a,
+         const T* b) const
+   {
+      if constexpr (N != dynamic_features)
+      {
+         T sum = 0;
+         for (std::size_t i = 0; i < N; ++i) sum += a[i] * b[i];
+         return sum;
+      }
+      else if constexpr (std::is_same<T, double>::value)
+      {
+         return dot_product(a, b, m_num_features);
+      }
+      else
+      {
+         T sum[4] = { 0, 0, 0, 0 };
+         std::size_t i = 0;
+
+         for (; i + 4 <= m_num_features; i += 4)
+         {
+            for (std::size_t j = 0; j < 4; ++j) sum[j] += a[i + j] * b[i + j];
+         }
+
+         for (; i < m_num_features; ++i) sum[0] += a[i] * b[i];
+         return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+      }
+   }
+
+   /**********************************************************************************************
+   * init_features: Sätter antalet insignaler vid dynamiskt antal ifall detta inte redan är
+   *                satt och allokerar vikterna. Returnerar true ifall angivet antal
+   *                överensstämmer med modellens antal insignaler.
+   *
+   *                - num_features: Antalet insignaler per träningsuppsättning i träningsdatan.
+   **********************************************************************************************/
+   bool init_features(const std::size_t num_features)
+   {
+      if constexpr (N == dynamic_features)
+      {
+         if (m_num_features == 0 && num_features > 0)
+         {
+            m_num_features = num_features;
+            m_weights.assign(num_features, 0);
+            m_train_in.reset(num_features);
+         }
+      }
+
+      m_row.resize(this->num_features() + 1);
+      if constexpr (Layout == matrix_layout::column_major) m_gather.resize(this->num_features());
+      return num_features > 0 && num_features == this->num_features();
+   }
+
+   /**********************************************************************************************
+   * append: Lägger till en träningsuppsättning bestående av angivna insignaler samt angiven
+   *         utsignal, vilka typomvandlas till T.
+   *
+   *         - input : Insignaler för träningsuppsättningen, en per vikt.
+   *         - output: Utsignal för träningsuppsättningen.
+   **********************************************************************************************/
+   template <typename U>
+   void append(const U* input,
+               const U output)
+   {
+      m_train_in.append_row(input);
+      m_train_out.push_back(static_cast<T>(output));
+      m_train_order.push_back(m_train_order.size());
+      return;
+   }
+
+   /**********************************************************************************************
+   * extract: Extraherar flyttal ur texten mellan angivna pekare och lagrar dessa som en
+   *          träningsuppsättning ifall raden innehåller en insignal per vikt följt av en
+   *          utsignal. Vid dynamiskt antal insignaler som ännu inte är satt avgörs antalet av
+   *          den första raden som innehåller minst två tal. Övriga rader, förutom tomma rader,
+   *          hoppas över och räknas via angiven statistik, likt tal som ej kunde typomvandlas.
+   *
+   *          - begin: Pekare till radens första tecken.
+   *          - end  : Pekare till adressen direkt efter radens sista tecken.
+   *          - stats: Statistik för pågående inläsning.
+   **********************************************************************************************/
+   void extract(const char* begin,
+                const char* end,
+                load_stats& stats)
+   {
+      if constexpr (N == dynamic_features)
+      {
+         if (m_num_features == 0)
+         {
+            double value;
+            std::size_t num_failures = 0;
+            const auto num_values = parse_numbers(begin, end, &value, 0, num_failures);
+            if (num_values >= 2) init_features(num_values - 1);
+         }
+      }
+
+      const auto num_values = num_features() + 1;
+
+      if (num_values > 1 && parse_numbers(begin, end, m_row.data(), num_values, stats.num_failures) == num_values)
+      {
+         append(m_row.data(), m_row[num_values - 1]);
+         stats.num_rows++;
+      }
+      else if (!line_is_blank(begin, end))
+      {
+         stats.num_skipped++;
+      }
+      return;
+   }
+
+   /**********************************************************************************************
+   * reserve_estimate: Uppskattar antalet träningsuppsättningar i en text om angivet antal byte
+   *                   utifrån genomsnittlig radlängd i textens början, som finns mellan angivna
+   *                   pekare [begin, end), och reserverar motsvarande plats för träningsdatan,
+   *                   så att vektorerna inte behöver allokeras om upprepade gånger vid
+   *                   inläsning av stora filer.
+   *
+   *                   - begin: Pekare till textens första tecken.
+   *                   - end  : Pekare till adressen direkt efter det sista tillgängliga tecknet.
+   *                   - size : Textens totala storlek i byte.
+   **********************************************************************************************/
+   void reserve_estimate(const char* begin,
+                         const char* end,
+                         const std::size_t size)
+   {
+      const auto available = static_cast<std::size_t>(end - begin);
+      const auto sample_size = available < 65536 ? available : 65536;
+      std::size_t num_lines = 0;
+
+      for (auto* i = begin; i < begin + sample_size; i = next_line(find_line_end(i, end), end))
+      {
+         num_lines++;
+      }
+
+      if (num_lines == 0) return;
+      reserve(m_train_out.size() + size / (sample_size / num_lines + 1) + 1);
+      return;
+   }
+
+   /**********************************************************************************************
+   * reset_order: Sätter antalet index för träningsuppsättningarna till angivet antal och lagrar
+   *              index i stigande ordning.
+   *
+   *              - num_sets: Antalet träningsuppsättningar.
+   **********************************************************************************************/
+   void reset_order(const std::size_t num_sets)
+   {
+      m_train_order.resize(num_sets);
+
+      for (std::size_t i = 0; i < num_sets; ++i)
+      {
+         m_train_order[i] = i;
+      }
+      return;
+   }
+
+   /**********************************************************************************************
+   * record_load: Registrerar statistik från inläsning av träningsdata, inklusive tidsåtgången,
+   *              i statistiken för tidsåtgång samt genomströmning.
+   *
+   *              - stats: Statistik från inläsningen.
+   **********************************************************************************************/
+   void record_load(const load_stats& stats)
+   {
+      m_instrumentation.add_parsed(stats.num_rows, stats.num_skipped, stats.num_failures);
+      m_instrumentation.add_time(training_phase::parse, stats.seconds);
+      return;
+   }
+
+   /**********************************************************************************************
+   * train_row: Returnerar en pekare till insignalerna för träningsuppsättningen med angivet
+   *            index. Vid radvis lagring pekar denna direkt in i matrisen, medan insignalerna
+   *            vid kolumnvis lagring först samlas ihop i bufferten m_gather.
+   *
+   *            - index: Index för träningsuppsättningen.
+   **********************************************************************************************/
+   const T* train_row(const std::size_t index)
+   {
+      if constexpr (Layout == matrix_layout::column_major)
+      {
+         for (std::size_t i = 0; i < num_features(); ++i)
+         {
+            m_gather[i] = m_train_in.at(index, i);
+         }
+         return m_gather.data();
+      }
+      else
+      {
+         return m_train_in.row(index);
+      }
+   }
+
+   /**********************************************************************************************
+   * move_from: Förflyttar samtliga medlemmar utom vektorerna med träningsdata från
+   *            regressionsmodellen source till angivet objekt this och nollställer därefter
+   *            source, vilket används av förflyttningskonstruktorn samt tilldelningsoperatorn.
+   *
+   *            - source: Den regressionsmodell som medlemmarna skall förflyttas från.
+   **********************************************************************************************/
+   void move_from(basic_lin_reg& source) noexcept
+   {
+      m_train_order = std::move(source.m_train_order);
+      m_batch_order = std::move(source.m_batch_order);
+      m_weights = std::move(source.m_weights);
+      m_gradient = std::move(source.m_gradient);
+      m_row = std::move(source.m_row);
+      m_gather = std::move(source.m_gather);
+      m_bias = source.m_bias;
+      m_learning_rate = source.m_learning_rate;
+      m_num_epochs = source.m_num_epochs;
+      m_batch_size = source.m_batch_size;
+      m_num_features = source.m_num_features;
+      m_data_version = source.m_data_version;
+      m_shuffler = std::move(source.m_shuffler);
+      m_instrumentation.take(source.m_instrumentation);
+
+      source.m_train_in.reset(N);
+      source.m_train_out.clear();
+      source.m_train_order.clear();
+      source.m_batch_order.clear();
+      source.m_data_version++;
+      source.m_weights = weight_storage{};
+      source.m_bias = 0;
+      source.m_learning_rate = 0;
+      source.m_num_epochs = 0;
+      source.m_batch_size = 1;
+      source.m_num_features = N;
+      return;
+   }
+
+   /**********************************************************************************************
+   * train_single: Tränar modellen under angivet antal epoker, där parametrarna justeras efter
+   *               varje träningsuppsättning via angiven funktion step. Inför varje epok
+   *               randomiseras ordningsföljden för de första num_sets träningsuppsättningarna,
+   *               vilket gör att exempelvis valideringsdata i slutet av vektorerna kan hållas
+   *               utanför träningen. Vikterna kopieras till lokala variabler under träningen,
+   *               vilket gör att kompilatorn kan hålla dessa i register vid fast antal
+   *               insignaler, och skrivs tillbaka efter varje epok.
+   *
+   *               - num_sets   : Antalet träningsuppsättningar som skall användas.
+   *               - step       : Justerar parametrarna för en träningsuppsättning, anropas med
+   *                              index för träningsuppsättningen, en pekare till vikterna
+   *                              samt en referens till vilovärdet.
+   *               - begin_epoch: Anropas med epokens index inför varje epok.
+   *               - end_epoch  : Anropas efter varje epok, returnerar true ifall träningen
+   *                              skall avbrytas.
+   **********************************************************************************************/
+   template <typename Step, typename BeginEpoch, typename EndEpoch>
+   void train_single(const std::size_t num_sets,
+                     Step&& step,
+                     BeginEpoch&& begin_epoch,
+                     EndEpoch&& end_epoch)
+   {
+      const auto partial = num_sets != m_train_order.size();
+      auto weights = m_weights;
+      auto bias = m_bias;
+
+      if (partial) reset_order(num_sets);
+
+      for (std::size_t i = 0; i < m_num_epochs; ++i)
+      {
+         begin_epoch(i);
+         const auto shuffle_start = m_instrumentation.now();
+         m_shuffler.shuffle(m_train_order);
+         m_instrumentation.add_time(training_phase::shuffle, shuffle_start);
+
+         for (const auto j : m_train_order)
+         {
+            step(j, weights.data(), bias);
+         }
+
+         m_weights = weights;
+         m_bias = bias;
+         if (end_epoch()) break;
+      }
+
+      if (partial) reset_order(m_train_out.size());
+      return;
+   }
+
+   /**********************************************************************************************
+   * train_single: Tränar modellen på samtliga träningsuppsättningar via vanlig stokastisk
+   *               gradientnedstigning, där parametrarna justeras efter varje
+   *               träningsuppsättning med lärhastigheten gånger aktuellt fel.
+   **********************************************************************************************/
+   void train_single(void)
+   {
+      const auto num_features = this->num_features();
+      const auto learning_rate = m_learning_rate;
+
+      train_single(num_sets(), [&](const std::size_t index, T* weights, T& bias)
+      {
+         const auto* input = train_row(index);
+         const auto change_rate = (m_train_out[index] - (dot(input, weights) + bias)) * learning_rate;
+         bias += change_rate;
+
+         for (std::size_t k = 0; k < num_features; ++k)
+         {
+            weights[k] += change_rate * input[k];
+         }
+      }, [](const std::size_t) { }, [](void) { return false; });
+      return;
+   }
+
+   /**********************************************************************************************
+   * accumulate: Beräknar felet för angiven träningsuppsättning och adderar detta till 
+   *             ackumulatorerna för angiven position inom en cacheline av ackumulatorer, där 
+   *             ackumulatorn för vilovärdet lagras först följt av en per vikt.
+   *
+   *             - index   : Index för träningsuppsättningen.
+   *             - lane    : Position inom ackumulatorerna, [0, num_lanes).
+   *             - weights : Modellens aktuella vikter.
+   *             - bias    : Modellens aktuella vilovärde.
+   *             - gradient: Ackumulatorer, (num_features() + 1) * num_lanes element.
+   **********************************************************************************************/
+   void accumulate(const std::size_t index,
+                   const std::size_t lane,
+                   const T* weights,
+                   const T bias,
+                   T* gradient)
+   {
+      const auto num_features = this->num_features();
+      const auto* input = train_row(index);
+      const auto error = m_train_out[index] - (dot(input, weights) + bias);
+      gradient[lane] += error;
+
+      for (std::size_t i = 0; i < num_features; ++i)
+      {
+         gradient[(i + 1) * num_lanes + lane] += error * input[i];
+      }
+      return;
+   }
+
+   /**********************************************************************************************
+   * train_mini_batch: Tränar modellen under angivet antal epoker via minibatcher bestående av
+   *                   sammanhängande träningsuppsättningar bland de första num_sets
+   *                   träningsuppsättningarna, där ordningsföljden för minibatcherna
+   *                   randomiseras inför varje epok och parametrarna justeras per minibatch via
+   *                   angiven funktion batch. Vikterna kopieras till lokala variabler under
+   *                   träningen och skrivs tillbaka efter varje epok.
+   *
+   *                   - num_sets   : Antalet träningsuppsättningar som skall användas.
+   *                   - batch      : Justerar parametrarna för en minibatch, anropas med index
+   *                                  för minibatchens första träningsuppsättning, antalet
+   *                                  träningsuppsättningar, en pekare till vikterna samt en
+   *                                  referens till vilovärdet.
+   *                   - begin_epoch: Anropas med epokens index inför varje epok.
+   *                   - end_epoch  : Anropas efter varje epok, returnerar true ifall träningen
+   *                                  skall avbrytas.
+   **********************************************************************************************/
+   template <typename Batch, typename BeginEpoch, typename EndEpoch>
+   void train_mini_batch(const std::size_t num_sets,
+                         Batch&& batch,
+                         BeginEpoch&& begin_epoch,
+                         EndEpoch&& end_epoch)
+   {
+      const auto num_batches = (num_sets + m_batch_size - 1) / m_batch_size;
+      auto weights = m_weights;
+      auto bias = m_bias;
+
+      m_batch_order.resize(num_batches);
+
+      for (std::size_t i = 0; i < num_batches; ++i)
+      {
+         m_batch_order[i] = i;
+      }
+
+      for (std::size_t i = 0; i < m_num_epochs; ++i)
+      {
+         begin_epoch(i);
+         const auto shuffle_start = m_instrumentation.now();
+         m_shuffler.shuffle(m_batch_order);
+         m_instrumentation.add_time(training_phase::shuffle, shuffle_start);
+
+         for (const auto j : m_batch_order)
+         {
+            const auto first = j * m_batch_size;
+            const auto last = first + m_batch_size < num_sets ? first + m_batch_size : num_sets;
+            batch(first, last - first, weights.data(), bias);
+         }
+
+         m_weights = weights;
+         m_bias = bias;
+         if (end_epoch()) break;
+      }
+      return;
+   }
+
+   /**********************************************************************************************
+   * train_mini_batch: Tränar modellen på samtliga träningsuppsättningar via minibatcher, där
+   *                   gradienterna ackumuleras i num_lanes oberoende ackumulatorer per
+   *                   parameter, vilka saknar beroenden mellan iterationerna och därmed kan
+   *                   behandlas via SIMD-instruktioner. Vid fast antal insignaler lagras
+   *                   ackumulatorerna på stacken, vilket gör att kompilatorn kan utesluta att
+   *                   dessa överlappar träningsdatan.
+   **********************************************************************************************/
+   void train_mini_batch(void)
+   {
+      const auto num_features = this->num_features();
+      std::array<T, N != dynamic_features ? (N + 1) * num_lanes : 1> local_gradient;
+
+      m_gradient.resize(N != dynamic_features ? 0 : (num_features + 1) * num_lanes);
+      auto* gradient = N != dynamic_features ? local_gradient.data() : m_gradient.data();
+      const auto gradient_size = (num_features + 1) * num_lanes;
+
+      train_mini_batch(num_sets(), [&](const std::size_t first, 
+                                       const std::size_t size, 
+                                       T* weights, 
+                                       T& bias)
+      {
+         const auto last = first + size;
+         auto k = first;
+
+         std::fill(gradient, gradient + gradient_size, T(0));
+
+         for (; k + num_lanes <= last; k += num_lanes)
+         {
+            for (std::size_t l = 0; l < num_lanes; ++l)
+            {
+               accumulate(k + l, l, weights, bias, gradient);
+            }
+         }
+
+         for (std::size_t l = 0; k + l < last; ++l)
+         {
+            accumulate(k + l, l, weights, bias, gradient);
+         }
+
+         const auto change_rate = m_learning_rate / static_cast<T>(size);
+
+         for (std::size_t m = 0; m <= num_features; ++m)
+         {
+            T sum = 0;
+            for (std::size_t l = 0; l < num_lanes; ++l) sum += gradient[m * num_lanes + l];
+
+            if (m == 0)
+            {
+               bias += change_rate * sum;
+            }
+            else
+            {
+               weights[m - 1] += change_rate * sum;
+            }
+         }
+      }, [](const std::size_t) { }, [](void) { return false; });
+      return;
+   }
+
+public:
+   /**********************************************************************************************
+   * basic_lin_reg: Konstruktor, som initierar en ny regressionsmodell utan träningsdata. Vid
+   *                dynamiskt antal insignaler avgörs antalet av den första träningsdatan.
+   **********************************************************************************************/
+   basic_lin_reg(void)
+      : m_train_in(N) { }
+
+   /**********************************************************************************************
+   * basic_lin_reg: Konstruktor, som initierar en ny regressionsmodell utan träningsdata, där
+   *                träningsdatan allokeras via angiven minnesresurs, exempelvis en arena
+   *                (std::pmr::monotonic_buffer_resource) eller en resurs som allokerar stora
+   *                sidor. Minnesresursen måste leva längre än regressionsmodellen.
+   *
+   *                - resource: Minnesresurs för vektorerna med träningsdata.
+   **********************************************************************************************/
+   explicit basic_lin_reg(std::pmr::memory_resource* resource)
+      : m_train_in(N, resource),
+        m_train_out(resource) { }
+
+   /**********************************************************************************************
+   * basic_lin_reg: Konstruktor, som initierar en ny regressionsmodell med angivet antal epoker
+   *                samt lärhastighet. Samtliga vikter sätts till noll.
+   *
+   *                - num_epochs   : Antalet epoker/omgångar som skall genomföras vid träning.
+   *                - learning_rate: Lärhastighet, avgör med hur stor andel av aktuellt fel som
+   *                                 modellens parametrar skall justeras.
+   *                - num_features : Antalet insignaler vid dynamiskt antal (default = N),
+   *                                 ignoreras vid fast antal insignaler.
+   *                - resource     : Minnesresurs för träningsdatan (default =
+   *                                 std::pmr::get_default_resource()).
+   **********************************************************************************************/
+   basic_lin_reg(const std::size_t num_epochs,
+                 const T learning_rate,
+                 const std::size_t num_features = N,
+                 std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : m_train_in(N, resource),
+        m_train_out(resource)
+   {
+      init_features(num_features);
+      set_epochs(num_epochs);
+      set_learning_rate(learning_rate);
+      return;
+   }
+
+   ~basic_lin_reg(void) { }
+   basic_lin_reg(basic_lin_reg&) = delete;
+   basic_lin_reg& operator = (basic_lin_reg&) = delete;
+
+   /**********************************************************************************************
+   * basic_lin_reg: Förflyttningskonstruktor, som medför förflyttning av minne från source till
+   *                angivet objekt this, tillsammans med minnesresursen för träningsdatan.
+   *                Efter förflyttningen är source tom.
+   *
+   *                - source: Den regressionsmodell som minnet skall förflyttas från.
+   **********************************************************************************************/
+   basic_lin_reg(basic_lin_reg&& source) noexcept
+      : m_train_in(std::move(source.m_train_in)),
+        m_train_out(std::move(source.m_train_out))
+   {
+      move_from(source);
+      return;
+   }
+
+   /**********************************************************************************************
+   * operator =: Förflyttar innehållet i regressionsmodellen source till angivet objekt this,
+   *             varefter source nollställs. Angiven modell behåller sin minnesresurs för
+   *             träningsdatan. Ifall båda modellerna använder samma minnesresurs, vilket gäller
+   *             som default, förflyttas träningsdatan utan att minne allokeras eller kopieras.
+   *             Annars kopieras träningsdatan till minne från angiven modells resurs.
+   *
+   *             - source: Den regressionsmodell som minnet skall förflyttas från.
+   **********************************************************************************************/
+   basic_lin_reg& operator = (basic_lin_reg&& source)
+   {
+      if (this != &source)
+      {
+         m_train_in = std::move(source.m_train_in);
+         m_train_out = std::move(source.m_train_out);
+         move_from(source);
+      }
+      return *this;
+   }
+
+   std::size_t num_features(void) const { return N != dynamic_features ? N : m_num_features; }
+   std::size_t num_sets(void) const { return m_train_out.size(); }
+   const weight_storage& weights(void) const { return m_weights; }
+   T bias(void) const { return m_bias; }
+   T learning_rate(void) const { return m_learning_rate; }
+   std::size_t epochs(void) const { return m_num_epochs; }
+   std::size_t batch_size(void) const { return m_batch_size; }
+   static constexpr matrix_layout layout(void) { return Layout; }
+   std::pmr::memory_resource* resource(void) const { return m_train_in.resource(); }
+   const feature_matrix<T, Layout>& training_inputs(void) const { return m_train_in; }
+   const aligned_vector<T>& training_outputs(void) const { return m_train_out; }
+   training_stats training_statistics(void) const { return m_instrumentation.stats(); }
+
+   /**********************************************************************************************
+   * set_epochs: Uppdaterar antalet epoker som sker vid träning ifall angivet nytt antal
+   *             överstiger noll.
+   *
+   *             - num_epochs: Det nya antalet epoker som skall genomföras vid träning.
+   **********************************************************************************************/
+   void set_epochs(const std::size_t num_epochs)
+   {
+      if (num_epochs > 0) m_num_epochs = num_epochs;
+      return;
+   }
+
+   /**********************************************************************************************
+   * set_learning_rate: Sätter ny lärhastighet ifall angivet nytt värde överstiger noll.
+   *
+   *                    - learning_rate: Den nya lärhastighet som skall användas för att
+   *                                     justera modellens parametrar vid fel.
+   **********************************************************************************************/
+   void set_learning_rate(const T learning_rate)
+   {
+      if (learning_rate > 0) m_learning_rate = learning_rate;
+      return;
+   }
+
+   /**********************************************************************************************
+   * set_batch_size: Sätter antalet träningsuppsättningar per minibatch ifall angivet nytt värde
+   *                 överstiger noll. Vid en batchstorlek på ett justeras parametrarna efter
+   *                 varje träningsuppsättning.
+   *
+   *                 - batch_size: Det nya antalet träningsuppsättningar per minibatch.
+   **********************************************************************************************/
+   void set_batch_size(const std::size_t batch_size)
+   {
+      if (batch_size > 0) m_batch_size = batch_size;
+      return;
+   }
+
+   /**********************************************************************************************
+   * set_seed: Sätter frö för slumptalsgeneratorn som randomiserar ordningsföljden för
+   *           träningsuppsättningarna, vilket gör att träningen kan upprepas med identiskt
+   *           resultat.
+   *
+   *           - seed: Det nya fröet.
+   **********************************************************************************************/
+   void set_seed(const std::uint64_t seed)
+   {
+      m_shuffler.seed(seed);
+      return;
+   }
+
+   /**********************************************************************************************
+   * set_shuffle_mode: Väljer metod för randomisering av ordningsföljden för
+   *                   träningsuppsättningarna inför varje epok.
+   *
+   *                   - mode      : Metod för randomisering.
+   *                   - block_size: Antalet träningsuppsättningar per block vid blockvis
+   *                                 metod (default = 4096).
+   **********************************************************************************************/
+   void set_shuffle_mode(const shuffle_mode mode,
+                         const std::size_t block_size = 4096)
+   {
+      m_shuffler.set_mode(mode, block_size);
+      return;
+   }
+
+   /**********************************************************************************************
+   * set_statistics_callback: Sätter återanropsfunktion som anropas med aktuell statistik för
+   *                          tidsåtgång samt genomströmning efter varje epok, exempelvis för
+   *                          att vidarebefordra statistiken till ett övervakningssystem.
+   *                          Funktionen anropas i den tråd som tränar modellen. Ifall makrot
+   *                          LIN_REG_INSTRUMENTATION inte har definierats anropas funktionen
+   *                          aldrig.
+   *
+   *                          - callback: Återanropsfunktionen (tom funktion = ingen).
+   **********************************************************************************************/
+   void set_statistics_callback(instrumentation::callback callback)
+   {
+      m_instrumentation.set_callback(std::move(callback));
+      return;
+   }
+
+   /**********************************************************************************************
+   * reset_training_statistics: Nollställer insamlad statistik för tidsåtgång samt
+   *                            genomströmning.
+   **********************************************************************************************/
+   void reset_training_statistics(void)
+   {
+      m_instrumentation.reset();
+      return;
+   }
+
+   /**********************************************************************************************
+   * reserve: Reserverar plats för angivet antal träningsuppsättningar, så att ingen allokering
+   *          sker när träningsdata läses in eller läggs till upp till detta antal.
+   *
+   *          - num_sets: Antalet träningsuppsättningar som plats skall reserveras för.
+   **********************************************************************************************/
+   void reserve(const std::size_t num_sets)
+   {
+      m_train_in.reserve(num_sets);
+      m_train_out.reserve(num_sets);
+      m_train_order.reserve(num_sets);
+      return;
+   }
+
+   /**********************************************************************************************
+   * load_training_data: Läser in träningsdata från en fil via angiven filsökväg, där varje rad
+   *                     som innehåller en insignal per vikt följt av en utsignal lagras som en
+   *                     träningsuppsättning. Filens första block läses in i en buffert, som
+   *                     används för att uppskatta antalet rader, så att plats kan reserveras
+   *                     för träningsdatan i förväg, varefter blockets rader tolkas direkt ur
+   *                     bufferten. Därefter läses resterande rader in en i taget till samma
+   *                     sträng.
+   *
+   *                     Uppskattningen hoppas över ifall filens storlek inte kan avgöras,
+   *                     exempelvis vid inläsning från en namngiven pipe eller /dev/stdin.
+   *                     Eftersom filen enbart läses framåt fungerar inläsningen även för sådana
+   *                     strömmar. Statistik för inläsningen returneras.
+   *
+   *                     - filepath: Filsökvägen som träningsdatan skall läsas från.
+   **********************************************************************************************/
+   load_stats load_training_data(const std::string& filepath)
+   {
+      load_stats stats;
+      const auto start = std::chrono::steady_clock::now();
+      std::ifstream fstream(filepath, std::ios::in);
+
+      if (!fstream)
+      {
+         std::cerr << "Could not open file at path " << filepath << "!\n\n";
+      }
+      else
+      {
+         fstream.seekg(0, std::ios::end);
+         const auto size = fstream.tellg();
+         fstream.clear();
+         fstream.seekg(0, std::ios::beg);
+         fstream.clear();
+
+         std::string s(65536, '\0');
+         fstream.read(&s[0], static_cast<std::streamsize>(s.size()));
+         const auto num_read = static_cast<std::size_t>(fstream.gcount());
+         const auto* end = s.data() + num_read;
+         const auto* i = s.data();
+         stats.num_bytes = num_read;
+         init_features(num_features());
+
+         if (size > 0)
+         {
+            reserve_estimate(i, end, static_cast<std::size_t>(size));
+         }
+
+         for (auto* line_end = find_line_end(i, end); line_end < end; line_end = find_line_end(i, end))
+         {
+            extract(i, line_end, stats);
+            i = line_end + 1;
+         }
+
+         const auto num_parsed = static_cast<std::size_t>(i - s.data());
+         s.resize(num_read);
+         s.erase(0, num_parsed);
+
+         for (char c; fstream.get(c);)
+         {
+            stats.num_bytes++;
+            if (c == '\n') break;
+            s.push_back(c);
+         }
+
+         extract(s.data(), s.data() + s.size(), stats);
+
+         while (std::getline(fstream, s))
+         {
+            stats.num_bytes += s.size() + (fstream.eof() ? 0 : 1);
+            extract(s.data(), s.data() + s.size(), stats);
+         }
+      }
+
+      stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      m_data_version++;
+      record_load(stats);
+      return stats;
+   }
+
+   /**********************************************************************************************
+   * load_training_data_mapped: Läser in träningsdata från en fil via angiven filsökväg likt
+   *                            load_training_data, men via minnesmappning av filen. Flyttal
+   *                            extraheras direkt ur den mappade filen via std::from_chars utan
+   *                            heapallokering per rad eller per tal, vilket medför att även
+   *                            mycket stora filer kan läsas in i närheten av diskens
+   *                            bandbredd. Innan inläsningen uppskattas antalet rader utifrån
+   *                            filens början, så att plats kan reserveras i förväg. Statistik
+   *                            för inläsningen returneras.
+   *
+   *                            - filepath: Filsökvägen som träningsdatan skall läsas från.
+   **********************************************************************************************/
+   load_stats load_training_data_mapped(const std::string& filepath)
+   {
+      load_stats stats;
+      const auto start = std::chrono::steady_clock::now();
+      const mapped_file file(filepath);
+
+      if (!file.is_open())
+      {
+         std::cerr << "Could not open file at path " << filepath << "!\n\n";
+         return stats;
+      }
+
+      const auto* begin = file.data();
+      const auto* end = begin + file.size();
+      init_features(num_features());
+      reserve_estimate(begin, end, file.size());
+
+      for (auto* i = begin; i < end;)
+      {
+         const auto* line_end = find_line_end(i, end);
+         extract(i, line_end, stats);
+         i = next_line(line_end, end);
+      }
+
+      stats.num_bytes = file.size();
+      stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      m_data_version++;
+      record_load(stats);
+      return stats;
+   }
+
+   /**********************************************************************************************
+   * load_binary_data: Läser in träningsdata från en binär fil skapad via
+   *                   convert_text_to_binary, där antalet insignaler måste överensstämma med
+   *                   modellens antal. Kolumner vars datatyp överensstämmer med T kopieras
+   *                   direkt ur den mappade filen, vilket gör att exempelvis filer med
+   *                   flyttal av enkel precision kan läsas in till en modell med T = float
+   *                   utan typomvandling. Kolumnerna läses i block om binary_block_rows rader
+   *                   och flätas samman rad för rad, förutom vid en insignal samt vid
+   *                   kolumnvis lagring, där kolumnerna kopieras direkt till matrisen för
+   *                   träningsdatan. Statistik för inläsningen returneras.
+   *
+   *                   - filepath: Filsökvägen som träningsdatan skall läsas från.
+   **********************************************************************************************/
+   load_stats load_binary_data(const std::string& filepath)
+   {
+      load_stats stats;
+      const auto start = std::chrono::steady_clock::now();
+      const binary_reader reader(filepath);
+
+      if (!reader.is_valid() || !init_features(reader.num_features()))
+      {
+         std::cerr << "Invalid binary training data at path " << filepath << "!\n\n";
+         return stats;
+      }
+
+      const auto num_features = this->num_features();
+      const auto num_rows = reader.num_rows();
+      const auto direct = 
+         (std::is_same<T, float>::value && reader.dtype() == binary_dtype::float32) ||
+         (std::is_same<T, double>::value && reader.dtype() == binary_dtype::float64);
+      const auto first = m_train_out.size();
+      const auto interleave = num_features > 1 && Layout == matrix_layout::row_major;
+      std::vector<T> block(interleave ? num_features * binary_block_rows : 0);
+      std::vector<double> column(direct ? 0 : binary_block_rows);
+
+      m_train_in.resize(first + num_rows);
+      m_train_out.resize(first + num_rows);
+      m_train_order.resize(first + num_rows);
+
+      auto read = [&](const std::size_t index,
+                      const std::size_t first_row,
+                      const std::size_t count,
+                      T* output)
+      {
+         if (direct)
+         {
+            std::memcpy(output, static_cast<const T*>(reader.column(index)) + first_row, count * sizeof(T));
+         }
+         else
+         {
+            reader.read_column(index, first_row, count, column.data());
+            for (std::size_t i = 0; i < count; ++i) output[i] = static_cast<T>(column[i]);
+         }
+      };
+
+      for (std::size_t i = 0; i < num_rows; i += binary_block_rows)
+      {
+         const auto count = i + binary_block_rows < num_rows ? binary_block_rows : num_rows - i;
+         read(num_features, i, count, &m_train_out[first + i]);
+
+         if (!interleave)
+         {
+            for (std::size_t j = 0; j < num_features; ++j)
+            {
+               read(j, i, count, &m_train_in.at(first + i, j));
+            }
+         }
+         else
+         {
+            for (std::size_t j = 0; j < num_features; ++j)
+            {
+               read(j, i, count, &block[j * binary_block_rows]);
+            }
+
+            for (std::size_t j = 0; j < count; ++j)
+            {
+               for (std::size_t k = 0; k < num_features; ++k)
+               {
+                  m_train_in.at(first + i + j, k) = block[k * binary_block_rows + j];
+               }
+            }
+         }
+      }
+
+      for (auto i = first; i < first + num_rows; ++i)
+      {
+         m_train_order[i] = i;
+      }
+
+      stats.num_rows = num_rows;
+      stats.num_bytes = reader.size();
+      stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      m_data_version++;
+      record_load(stats);
+      return stats;
+   }
+
+   /**********************************************************************************************
+   * set_training_data: Kopierar träningsdata till angiven regressionsmodell från refererade
+   *                    vektorer, där varje element i train_in innehåller insignalerna för en
+   *                    träningsuppsättning. Enbart fullständiga träningsuppsättningar med rätt
+   *                    antal insignaler samt en motsvarande utsignal lagras.
+   *
+   *                    - train_in : Innehåller insignaler för samtliga träningsuppsättningar.
+   *                    - train_out: Innehåller utsignaler för samtliga träningsuppsättningar.
+   **********************************************************************************************/
+   void set_training_data(const std::vector<std::vector<T>>& train_in,
+                          const std::vector<T>& train_out)
+   {
+      const auto num_sets = train_in.size() < train_out.size() ? train_in.size() : train_out.size();
+
+      m_data_version++;
+      m_train_in.clear();
+      m_train_out.clear();
+      m_train_order.clear();
+      if (num_sets == 0 || !init_features(train_in[0].size())) return;
+      m_train_in.reserve(num_sets);
+      m_train_out.reserve(num_sets);
+      m_train_order.reserve(num_sets);
+
+      for (std::size_t i = 0; i < num_sets; ++i)
+      {
+         if (train_in[i].size() == num_features())
+         {
+            append(train_in[i].data(), train_out[i]);
+         }
+      }
+      return;
+   }
+
+   /**********************************************************************************************
+   * set_training_data: Kopierar träningsdata till angiven regressionsmodell från refererade
+   *                    vektorer, där train_in innehåller insignalerna radvis. Vid dynamiskt
+   *                    antal insignaler som ännu inte är satt avgörs antalet utifrån
+   *                    vektorernas storlek. Enbart fullständiga träningsuppsättningar lagras.
+   *
+   *                    - train_in : Innehåller insignaler för samtliga träningsuppsättningar.
+   *                    - train_out: Innehåller utsignaler för samtliga träningsuppsättningar.
+   **********************************************************************************************/
+   void set_training_data(const std::vector<T>& train_in,
+                          const std::vector<T>& train_out)
+   {
+      m_data_version++;
+      m_train_in.clear();
+      m_train_out.clear();
+      m_train_order.clear();
+
+      if (num_features() == 0 && train_out.size() > 0 && train_in.size() % train_out.size() == 0)
+      {
+         init_features(train_in.size() / train_out.size());
+      }
+
+      const auto num_features = this->num_features();
+      auto num_sets = num_features > 0 ? train_in.size() / num_features : 0;
+      if (num_sets > train_out.size()) num_sets = train_out.size();
+      if (!init_features(num_features)) return;
+
+      m_train_in.assign(train_in.data(), num_sets);
+      m_train_out.assign(train_out.begin(), train_out.begin() + num_sets);
+      reset_order(num_sets);
+      return;
+   }
+
+   /**********************************************************************************************
+   * set_training_data: Tar över refererade vektorer av typen std::vector som träningsdata för
+   *                    angiven regressionsmodell, där train_in innehåller insignalerna radvis.
+   *                    Eftersom std::vector inte använder modellens justerade allokerare kan
+   *                    minnet inte förflyttas, utan träningsdatan kopieras, varefter
+   *                    vektorernas minne frigörs. Använd aligned_vector för att undvika
+   *                    kopieringen. Utan denna överlagring skulle förflyttade vektorer i tysthet
+   *                    kopieras via överlagringen för konstanta referenser.
+   *
+   *                    - train_in : Innehåller insignaler för samtliga träningsuppsättningar.
+   *                    - train_out: Innehåller utsignaler för samtliga träningsuppsättningar.
+   **********************************************************************************************/
+   void set_training_data(std::vector<T>&& train_in,
+                          std::vector<T>&& train_out)
+   {
+      set_training_data(static_cast<const std::vector<T>&>(train_in),
+                        static_cast<const std::vector<T>&>(train_out));
+      std::vector<T>().swap(train_in);
+      std::vector<T>().swap(train_out);
+      return;
+   }
+
+   /**********************************************************************************************
+   * set_training_data: Tar över refererade vektorer som träningsdata för angiven
+   *                    regressionsmodell, där train_in innehåller insignalerna radvis. Ifall
+   *                    vektorerna använder samma minnesresurs som modellen, vilket gäller som
+   *                    default, förflyttas minnet utan att träningsdatan kopieras. Enbart
+   *                    fullständiga träningsuppsättningar behålls.
+   *
+   *                    - train_in : Innehåller insignaler för samtliga träningsuppsättningar.
+   *                    - train_out: Innehåller utsignaler för samtliga träningsuppsättningar.
+   **********************************************************************************************/
+   void set_training_data(aligned_vector<T>&& train_in,
+                          aligned_vector<T>&& train_out)
+   {
+      m_data_version++;
+
+      if (num_features() == 0 && train_out.size() > 0 && train_in.size() % train_out.size() == 0)
+      {
+         init_features(train_in.size() / train_out.size());
+      }
+
+      const auto num_features = this->num_features();
+      auto num_sets = num_features > 0 ? train_in.size() / num_features : 0;
+      if (num_sets > train_out.size()) num_sets = train_out.size();
+
+      init_features(num_features);
+      m_train_in.assign(std::move(train_in), num_sets);
+      m_train_out = std::move(train_out);
+      m_train_out.resize(num_sets);
+      reset_order(num_sets);
+      return;
+   }
+
+   /**********************************************************************************************
+   * train: Tränar angiven regressionsmodell under angivet antal epoker via stokastisk
+   *        gradientnedstigning, per träningsuppsättning eller via minibatcher beroende på
+   *        vald batchstorlek.
+   **********************************************************************************************/
+   void train(void)
+   {
+      if (num_features() == 0) return;
+
+      if (m_batch_size > 1)
+      {
+         train_mini_batch();
+      }
+      else
+      {
+         train_single();
+      }
+      return;
+   }
+
+   /**********************************************************************************************
+   * predict: Genomför prediktion med angiven regressionsmodell via angivna insignaler och
+   *          returnerar motsvarande predikterad utsignal, beräknad som skalärprodukten av
+   *          insignalerna och vikterna plus vilovärdet.
+   *
+   *          - input: Pekare till en array innehållande en insignal per vikt.
+   **********************************************************************************************/
+   T predict(const T* input) const
+   {
+      return dot(input, m_weights.data()) + m_bias;
+   }
+
+   /**********************************************************************************************
+   * predict: Genomför prediktion med angiven regressionsmodell via angivna insignaler. Ifall
+   *          antalet insignaler inte överensstämmer med antalet vikter skrivs ett felmeddelande
+   *          ut och NaN returneras, så att felet inte kan misstas för en giltig prediktion.
+   *
+   *          - input: Vektor innehållande en insignal per vikt.
+   **********************************************************************************************/
+   T predict(const std::vector<T>& input) const
+   {
+      if (input.size() != num_features())
+      {
+         std::cerr << "Expected " << num_features() << " inputs for prediction, got "
+                   << input.size() << "!\n\n";
+         return std::numeric_limits<T>::quiet_NaN();
+      }
+      return predict(input.data());
+   }
+
+   /**********************************************************************************************
+   * predict_batch: Genomför prediktion för angivet antal uppsättningar, där insignalerna
+   *                lagras radvis i arrayen input, och skriver predikterade utsignaler till
+   *                arrayen output, som tillhandahålls av anroparen. Vid flyttal av dubbel
+   *                precision samt en insignal sker beräkningen via beräkningskärnan
+   *                predict_linear, som vid mycket stora mängder data skriver resultatet förbi
+   *                cacheminnet. Vid övriga fasta antal insignaler kopieras vikterna till lokala
+   *                variabler, så att kompilatorn inte behöver läsa om dessa efter varje
+   *                skrivning till output, och uppsättningarna behandlas i grupper om num_lanes
+   *                med känt antal iterationer. Ingen allokering sker och modellen läses enbart,
+   *                vilket gör att flera trådar kan genomföra prediktion samtidigt med samma
+   *                modell.
+   *
+   *                - input   : Insignaler lagrade radvis, num_sets * num_features() element.
+   *                - output  : Array där num_sets predikterade utsignaler skall lagras.
+   *                - num_sets: Antalet uppsättningar som prediktion skall genomföras på.
+   **********************************************************************************************/
+   void predict_batch(const T* input,
+                      T* output,
+                      const std::size_t num_sets) const
+   {
+      const auto start = m_instrumentation.now();
+      const auto num_features = this->num_features();
+      const auto bias = m_bias;
+
+      if constexpr (N == 1 && std::is_same<T, double>::value)
+      {
+         predict_linear(input, output, num_sets, m_weights[0], bias);
+      }
+      else if constexpr (N != dynamic_features)
+      {
+         const auto weights = m_weights;
+         std::size_t i = 0;
+
+         for (; i + num_lanes <= num_sets; i += num_lanes)
+         {
+            for (std::size_t j = 0; j < num_lanes; ++j)
+            {
+               output[i + j] = dot(&input[(i + j) * num_features], weights.data()) + bias;
+            }
+         }
+
+         for (; i < num_sets; ++i)
+         {
+            output[i] = dot(&input[i * num_features], weights.data()) + bias;
+         }
+      }
+      else
+      {
+         for (std::size_t i = 0; i < num_sets; ++i)
+         {
+            output[i] = dot(&input[i * num_features], m_weights.data()) + bias;
+         }
+      }
+
+      m_instrumentation.add_predicted(num_sets, start);
+      return;
+   }
+
+   /**********************************************************************************************
+   * predict_batch: Genomför prediktion för samtliga uppsättningar i refererad vektor input,
+   *                där insignalerna lagras radvis, och lagrar predikterade utsignaler i
+   *                refererad vektor output, vars storlek sätts till antalet uppsättningar.
+   *                Ifall output redan har tillräcklig kapacitet sker ingen allokering.
+   *
+   *                - input : Vektor innehållande insignaler lagrade radvis.
+   *                - output: Vektor där predikterade utsignaler skall lagras.
+   **********************************************************************************************/
+   void predict_batch(const std::vector<T>& input,
+                      std::vector<T>& output) const
+   {
+      output.resize(num_features() > 0 ? input.size() / num_features() : 0);
+      predict_batch(input.data(), output.data(), output.size());
+      return;
+   }
+};
+
+#endif /* BASIC_LIN_REG_HPP_ */
@@ -0,0 +1,526 @@
+/**************************************************************************************************
+* benchmark.cpp: Mäter prestanda för inläsning, träning samt prediktion med klassen lin_reg på 
+*                syntetiska datamängder om 1e3 träningsuppsättningar och uppåt, med en 
+*                tiopotens mellan varje storlek. Resultatet skrivs ut i terminalen samt till en 
+*                JSON-fil i samma stil som Google Benchmark, vilket möjliggör att prestanda kan 
+*                jämföras mellan olika versioner.
+*
+*                Träning via minibatcher samt prediktion mäts även för klassmallen 
+*                basic_lin_reg med flyttal av enkel precision. Träning samt prediktion med 
+*                multi_features insignaler mäts för aliaset multi_lin_reg på datamängder om 
+*                högst max_multi_rows träningsuppsättningar, med radvis respektive kolumnvis 
+*                lagring av träningsdatan.
+*
+*                Inkrementell träning via partial_fit mäts för samma datamängd, både via 
+*                stokastisk gradientnedstigning och via den exakta minstakvadratlösningen.
+*
+*                Inläsning av en sparad modell mäts för att jämföras med tiden för träning, 
+*                medan prediktion även mäts via klassen model_server.
+*
+*                Utskrift av prediktioner mäts i läsbart format, CSV-format samt binärt format, 
+*                där utdatan kastas för att enbart formateringen skall mätas.
+*
+*                Tiden till konvergens vid tidigt avbrott mäts för olika metoder för justering 
+*                av parametrarna på datamängder om högst max_converge_rows 
+*                träningsuppsättningar, där antalet genomförda epoker ingår i mätningens namn.
+*                Sökning efter hyperparametrar via korsvalidering med fem veck mäts för samma 
+*                datamängder och olika antal trådar.
+*
+*                I Windows, kompilera koden och skapa en körbar fil benchmark.exe med följande 
+*                kommando (lägg gärna till -march=native för att använda SIMD-instruktioner):
+*                $ g++ benchmark.cpp lin_reg.cpp binary_data.cpp mapped_file.cpp text_parser.cpp regression_stats.cpp kernels.cpp thread_pool.cpp shuffler.cpp optimizer.cpp model_snapshot.cpp model_server.cpp prediction_writer.cpp hyper_sweep.cpp -o benchmark.exe -Wall -std=c++17 -O2
+*
+*                Kör sedan programmet med följande kommando, där största antalet 
+*                träningsuppsättningar (default = 1e7, maximalt 1e8) samt filsökväg för 
+*                resultatet (default = benchmark.json) är valfria:
+*                $ benchmark.exe [max_rows] [output.json]
+**************************************************************************************************/
+#include "lin_reg.hpp"
+#include "binary_data.hpp"
+#include "hyper_sweep.hpp"
+#include "kernels.hpp"
+#include "model_server.hpp"
+#include "multi_lin_reg.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <functional>
+
+/**************************************************************************************************
+* benchmark_result: Resultat från en enskild mätning.
+**************************************************************************************************/
+struct benchmark_result
+{
+   std::string name;           /* Mätningens namn. */
+   std::size_t num_rows = 0;   /* Antalet träningsuppsättningar. */
+   std::size_t iterations = 0; /* Antalet genomförda upprepningar. */
+   double seconds = 0;         /* Genomsnittlig tid per upprepning i sekunder. */
+   double items = 0;           /* Antalet behandlade element per upprepning. */
+   double bytes = 0;           /* Antalet behandlade byte per upprepning. */
+};
+
+/**************************************************************************************************
+* null_buffer: Strömbuffert som kastar all utdata, vilket används för att mäta formatering av 
+*              utskrifter utan att mäta terminalens eller diskens hastighet.
+**************************************************************************************************/
+class null_buffer : public std::streambuf
+{
+protected:
+   int overflow(int c) override { return c; }
+   std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+/* Statiska konstanter: */
+static constexpr double min_benchmark_time = 0.2; /* Minsta mättid per mätning i sekunder. */
+static constexpr std::size_t max_converge_rows = 1000000; /* Största datamängd vid mätning av konvergens. */
+static constexpr std::size_t max_multi_rows = 1000000; /* Största datamängd vid flera insignaler. */
+static constexpr std::size_t multi_features = 8;       /* Antalet insignaler för multi_lin_reg. */
+
+/* Statiska funktioner: */
+static void generate_data(const std::size_t num_rows,
+                          std::vector<double>& train_in,
+                          std::vector<double>& train_out);
+static void generate_multi_data(const std::size_t num_rows,
+                                std::vector<double>& train_in,
+                                std::vector<double>& train_out);
+static void write_text_file(const std::string& filepath,
+                            const std::vector<double>& train_in,
+                            const std::vector<double>& train_out);
+static benchmark_result measure(const std::string& name,
+                                const std::size_t num_rows,
+                                const double items,
+                                const double bytes,
+                                const std::function<void(void)>& function);
+static void print_result(const benchmark_result& result);
+static void write_json(const std::string& filepath,
+                       const std::vector<benchmark_result>& results);
+
+/**************************************************************************************************
+* main: Genomför samtliga mätningar för varje datamängdsstorlek från 1e3 upp till angivet 
+*       största antal träningsuppsättningar och skriver resultatet till en JSON-fil.
+**************************************************************************************************/
+int main(int argc, char** argv)
+{
+   const auto max_rows = argc > 1 ? static_cast<std::size_t>(std::stod(argv[1])) : 10000000;
+   const std::string json_path = argc > 2 ? argv[2] : "benchmark.json";
+   const std::string text_path = "benchmark_data.txt";
+   const std::string binary_path = "benchmark_data.bin";
+   const std::string model_path = "benchmark_model.bin";
+   const auto max_threads = std::thread::hardware_concurrency() > 0 ? 
+      std::thread::hardware_concurrency() : 1;
+
+   std::vector<benchmark_result> results;
+   null_buffer buffer;
+   std::ostream null_stream(&buffer);
+
+   for (std::size_t num_rows = 1000; num_rows <= max_rows && num_rows <= 100000000; num_rows *= 10)
+   {
+      std::vector<double> train_in, train_out, output(num_rows);
+      generate_data(num_rows, train_in, train_out);
+      write_text_file(text_path, train_in, train_out);
+      convert_text_to_binary(text_path, binary_path);
+
+      std::ifstream fstream(text_path, std::ios::in | std::ios::binary | std::ios::ate);
+      const auto text_size = static_cast<double>(fstream.tellg());
+      const auto data_size = 2.0 * sizeof(double) * num_rows;
+      fstream.close();
+
+      auto add = [&](const benchmark_result& result)
+      {
+         print_result(result);
+         results.push_back(result);
+      };
+
+      add(measure("load_training_data", num_rows, num_rows, text_size, [&](void)
+      {
+         lin_reg model;
+         model.load_training_data(text_path);
+      }));
+
+      add(measure("load_training_data_mapped", num_rows, num_rows, text_size, [&](void)
+      {
+         lin_reg model;
+         model.load_training_data_mapped(text_path);
+      }));
+
+      add(measure("load_binary_data", num_rows, num_rows, data_size, [&](void)
+      {
+         lin_reg model;
+         model.load_binary_data(binary_path);
+      }));
+
+      lin_reg model(1, 0.01);
+
+      add(measure("set_training_data", num_rows, num_rows, data_size, [&](void)
+      {
+         model.set_training_data(train_in, train_out);
+      }));
+
+      add(measure("train_epoch/sgd", num_rows, num_rows, data_size, [&](void)
+      {
+         model.train();
+      }));
+
+      if (num_rows <= max_converge_rows)
+      {
+         auto converge = [&](const std::string& name, 
+                             const optimizer_mode mode, 
+                             const double learning_rate,
+                             const bool standardize)
+         {
+            auto train_model = [&](void)
+            {
+               lin_reg converged(1000, learning_rate);
+               converged.set_optimizer(mode);
+               converged.set_standardization(standardize);
+               converged.set_early_stopping(1e-4, 3);
+               converged.set_training_data(train_in, train_out);
+               converged.train();
+               return converged.epochs_run();
+            };
+
+            const auto epochs = train_model();
+            add(measure("train_converge/" + name + "/epochs:" + std::to_string(epochs), num_rows, 
+                        static_cast<double>(num_rows * epochs), data_size * epochs, 
+                        [&](void) { train_model(); }));
+         };
+
+         converge("sgd", optimizer_mode::sgd, 0.01, false);
+         converge("momentum+std", optimizer_mode::momentum, 0.001, true);
+         converge("adam+std", optimizer_mode::adam, 0.01, true);
+
+         hyper_sweep sweep;
+         sweep.set_training_data(train_in, train_out);
+         sweep.add_grid({ 0.0001, 0.001, 0.01, 0.02 }, { 1, 2 });
+         sweep.set_folds(5);
+
+         for (std::size_t threads = 1; threads <= max_threads; threads *= 2)
+         {
+            sweep.set_num_threads(threads);
+
+            add(measure("hyper_sweep/threads:" + std::to_string(threads), num_rows, 
+                        48.0 * num_rows, 48 * data_size, [&](void) { sweep.run(); }));
+         }
+      }
+
+      add(measure("partial_fit/sgd", num_rows, num_rows, data_size, [&](void)
+      {
+         model.partial_fit(train_in, train_out);
+      }));
+
+      model.set_batch_size(1024);
+      model.set_learning_rate(0.1);
+
+      for (std::size_t threads = 1; threads <= max_threads; threads *= 2)
+      {
+         model.set_num_threads(threads);
+
+         add(measure("train_epoch/mini_batch/threads:" + std::to_string(threads), num_rows, 
+                     num_rows, data_size, [&](void) { model.train(); }));
+      }
+
+      model.set_solver(lin_reg::solver_mode::closed_form);
+
+      for (std::size_t threads = 1; threads <= max_threads; threads *= 2)
+      {
+         model.set_num_threads(threads);
+
+         add(measure("train/closed_form/threads:" + std::to_string(threads), num_rows, 
+                     num_rows, data_size, [&](void) { model.train(); }));
+      }
+
+      add(measure("partial_fit/closed_form", num_rows, num_rows, data_size, [&](void)
+      {
+         model.partial_fit(train_in, train_out);
+      }));
+
+      const auto& trained = model;
+      volatile double sink = 0;
+
+      add(measure("predict", num_rows, num_rows, data_size, [&](void)
+      {
+         double sum = 0;
+
+         for (auto& i : train_in)
+         {
+            sum += trained.predict(i);
+         }
+         sink = sum;
+      }));
+
+      add(measure("predict_batch", num_rows, num_rows, data_size, [&](void)
+      {
+         trained.predict_batch(train_in.data(), output.data(), num_rows);
+      }));
+
+      trained.save_model(model_path);
+      model_server server;
+      server.load(model_path);
+
+      add(measure("load_model", num_rows, 1, sizeof(model_snapshot), [&](void)
+      {
+         lin_reg loaded;
+         loaded.load_model(model_path);
+      }));
+
+      add(measure("predict_batch/model_server", num_rows, num_rows, data_size, [&](void)
+      {
+         server.predict_batch(train_in.data(), output.data(), num_rows);
+      }));
+
+      add(measure("predict_range", num_rows, num_rows, 0, [&](void)
+      {
+         trained.predict_range(0, static_cast<double>(num_rows - 1), 1, 0.001, null_stream);
+      }));
+
+      add(measure("predict_range/csv", num_rows, num_rows, 0, [&](void)
+      {
+         trained.predict_range(0, static_cast<double>(num_rows - 1), 1, 0.001, null_stream, 
+                               export_format::csv);
+      }));
+
+      add(measure("predict_range/binary", num_rows, num_rows, data_size, [&](void)
+      {
+         trained.predict_range(0, static_cast<double>(num_rows - 1), 1, 0.001, null_stream, 
+                               export_format::binary);
+      }));
+
+      add(measure("predict_all", num_rows, num_rows, 0, [&](void)
+      {
+         trained.predict_all(0.001, null_stream);
+      }));
+
+      std::vector<float> train_in_float(train_in.begin(), train_in.end());
+      std::vector<float> train_out_float(train_out.begin(), train_out.end());
+      std::vector<float> output_float(num_rows);
+      basic_lin_reg<float, 1> model_float(1, 0.1f);
+      model_float.set_training_data(train_in_float, train_out_float);
+      model_float.set_batch_size(1024);
+
+      add(measure("train_epoch/mini_batch/float", num_rows, num_rows, data_size / 2, [&](void)
+      {
+         model_float.train();
+      }));
+
+      add(measure("predict_batch/float", num_rows, num_rows, data_size / 2, [&](void)
+      {
+         model_float.predict_batch(train_in_float.data(), output_float.data(), num_rows);
+      }));
+
+      if (num_rows <= max_multi_rows)
+      {
+         std::vector<double> multi_in, multi_out;
+         const auto multi_size = (multi_features + 1.0) * sizeof(double) * num_rows;
+         generate_multi_data(num_rows, multi_in, multi_out);
+
+         multi_lin_reg<matrix_layout::row_major> multi_rows(1, 0.01, multi_features);
+         multi_lin_reg<matrix_layout::column_major> multi_cols(1, 0.01, multi_features);
+         multi_rows.set_training_data(multi_in, multi_out);
+         multi_cols.set_training_data(multi_in, multi_out);
+
+         add(measure("train_epoch/multi/row_major", num_rows, num_rows, multi_size, [&](void)
+         {
+            multi_rows.train();
+         }));
+
+         add(measure("train_epoch/multi/column_major", num_rows, num_rows, multi_size, [&](void)
+         {
+            multi_cols.train();
+         }));
+
+         add(measure("predict_batch/multi", num_rows, num_rows, multi_size, [&](void)
+         {
+            multi_rows.predict_batch(multi_in.data(), output.data(), num_rows);
+         }));
+      }
+
+      (void)sink;
+   }
+
+   std::remove(text_path.c_str());
+   std::remove(binary_path.c_str());
+   std::remove(model_path.c_str());
+   write_json(json_path, results);
+   return 0;
+}
+
+/**************************************************************************************************
+* generate_data: Genererar syntetisk träningsdata enligt formeln y = -2.5x + 10 med brus, där 
+*                insignalerna är slumpmässiga flyttal mellan -10 och 10. Ett fast frö används, 
+*                så att samma data genereras vid varje körning.
+*
+*                - num_rows : Antalet träningsuppsättningar som skall genereras.
+*                - train_in : Vektor där insignalerna skall lagras.
+*                - train_out: Vektor där utsignalerna skall lagras.
+**************************************************************************************************/
+static void generate_data(const std::size_t num_rows,
+                          std::vector<double>& train_in,
+                          std::vector<double>& train_out)
+{
+   std::mt19937_64 generator(1);
+   std::uniform_real_distribution<double> input(-10, 10);
+   std::normal_distribution<double> noise(0, 0.1);
+
+   train_in.resize(num_rows);
+   train_out.resize(num_rows);
+
+   for (std::size_t i = 0; i < num_rows; ++i)
+   {
+      train_in[i] = input(generator);
+      train_out[i] = -2.5 * train_in[i] + 10 + noise(generator);
+   }
+   return;
+}
+
+/**************************************************************************************************
+* generate_multi_data: Genererar syntetisk träningsdata med multi_features insignaler per 
+*                      träningsuppsättning, lagrade radvis, enligt formeln 
+*                      y = x0 - 2x1 + 3x2 - ... + 5 med brus, där insignalerna är slumpmässiga 
+*                      flyttal mellan -1 och 1. Ett fast frö används, så att samma data 
+*                      genereras vid varje körning.
+*
+*                      - num_rows : Antalet träningsuppsättningar som skall genereras.
+*                      - train_in : Vektor där insignalerna skall lagras radvis.
+*                      - train_out: Vektor där utsignalerna skall lagras.
+**************************************************************************************************/
+static void generate_multi_data(const std::size_t num_rows,
+                                std::vector<double>& train_in,
+                                std::vector<double>& train_out)
+{
+   std::mt19937_64 generator(2);
+   std::uniform_real_distribution<double> input(-1, 1);
+   std::normal_distribution<double> noise(0, 0.1);
+
+   train_in.resize(num_rows * multi_features);
+   train_out.resize(num_rows);
+
+   for (std::size_t i = 0; i < num_rows; ++i)
+   {
+      auto output = 5.0;
+
+      for (std::size_t j = 0; j < multi_features; ++j)
+      {
+         train_in[i * multi_features + j] = input(generator);
+         output += (j % 2 == 0 ? 1.0 : -1.0) * (j + 1) * train_in[i * multi_features + j];
+      }
+
+      train_out[i] = output + noise(generator);
+   }
+   return;
+}
+
+/**************************************************************************************************
+* write_text_file: Skriver angiven träningsdata till en textfil i samma format som data.txt, 
+*                  med en träningsuppsättning per rad.
+*
+*                  - filepath : Filsökvägen som träningsdatan skall skrivas till.
+*                  - train_in : Insignaler för träningsuppsättningarna.
+*                  - train_out: Utsignaler för träningsuppsättningarna.
+**************************************************************************************************/
+static void write_text_file(const std::string& filepath,
+                            const std::vector<double>& train_in,
+                            const std::vector<double>& train_out)
+{
+   auto* file = std::fopen(filepath.c_str(), "wb");
+   if (!file) return;
+
+   for (std::size_t i = 0; i < train_in.size(); ++i)
+   {
+      std::fprintf(file, "%.6f %.6f\n", train_in[i], train_out[i]);
+   }
+
+   std::fclose(file);
+   return;
+}
+
+/**************************************************************************************************
+* measure: Mäter genomsnittlig tid för angiven funktion. Funktionen upprepas tills den totala 
+*          tiden överstiger min_benchmark_time, dock minst en gång. Resultatet returneras.
+*
+*          - name    : Mätningens namn.
+*          - num_rows: Antalet träningsuppsättningar i datamängden.
+*          - items   : Antalet behandlade element per anrop.
+*          - bytes   : Antalet behandlade byte per anrop.
+*          - function: Den funktion som skall mätas.
+**************************************************************************************************/
+static benchmark_result measure(const std::string& name,
+                                const std::size_t num_rows,
+                                const double items,
+                                const double bytes,
+                                const std::function<void(void)>& function)
+{
+   benchmark_result result;
+   result.name = name;
+   result.num_rows = num_rows;
+   result.items = items;
+   result.bytes = bytes;
+
+   const auto start = std::chrono::steady_clock::now();
+   double elapsed = 0;
+
+   while (result.iterations == 0 || elapsed < min_benchmark_time)
+   {
+      function();
+      result.iterations++;
+      elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   }
+
+   result.seconds = elapsed / result.iterations;
+   return result;
+}
+
+/**************************************************************************************************
+* print_result: Skriver ut angivet resultat i terminalen.
+*
+*               - result: Det resultat som skall skrivas ut.
+**************************************************************************************************/
+static void print_result(const benchmark_result& result)
+{
+   std::printf("%-40s %10zu rows %12.3f ms %14.0f items/s %10.1f MB/s\n", result.name.c_str(), 
+               result.num_rows, result.seconds * 1e3, result.items / result.seconds, 
+               result.bytes / result.seconds / 1e6);
+   return;
+}
+
+/**************************************************************************************************
+* write_json: Skriver samtliga resultat till en JSON-fil, där varje mätning namnges efter 
+*             funktionen som mättes följt av antalet träningsuppsättningar.
+*
+*             - filepath: Filsökvägen som resultatet skall skrivas till.
+*             - results : De resultat som skall skrivas.
+**************************************************************************************************/
+static void write_json(const std::string& filepath,
+                       const std::vector<benchmark_result>& results)
+{
+   std::ofstream ofstream(filepath, std::ios::out);
+
+   if (!ofstream)
+   {
+      std::cerr << "Could not open file at path " << filepath << "!\n\n";
+      return;
+   }
+
+   ofstream << "{\n  \"context\": {\n";
+   ofstream << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+   ofstream << "    \"kernel_isa\": \"" << kernel_isa() << "\"\n  },\n";
+   ofstream << "  \"benchmarks\": [\n";
+
+   for (std::size_t i = 0; i < results.size(); ++i)
+   {
+      const auto& result = results[i];
+      ofstream << "    {\n";
+      ofstream << "      \"name\": \"" << result.name << "/" << result.num_rows << "\",\n";
+      ofstream << "      \"rows\": " << result.num_rows << ",\n";
+      ofstream << "      \"iterations\": " << result.iterations << ",\n";
+      ofstream << "      \"real_time\": " << result.seconds * 1e9 << ",\n";
+      ofstream << "      \"time_unit\": \"ns\",\n";
+      ofstream << "      \"items_per_second\": " << result.items / result.seconds << ",\n";
+      ofstream << "      \"bytes_per_second\": " << result.bytes / result.seconds << "\n";
+      ofstream << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+   }
+
+   ofstream << "  ]\n}\n";
+   return;
+}
@@ -0,0 +1,121 @@
+/**************************************************************************************************
+* binary_check.cpp: Kontrollerar att klassen binary_reader avvisar binära filer med skadade
+*                   huvuden. En giltig fil med två insignaler per rad skapas först via
+*                   convert_text_to_binary och läses in, varefter huvudet ändras så att
+*                   kolumnernas positioner pekar utanför filen, exempelvis via ett avstånd
+*                   mellan kolumnerna som ger spill vid multiplikation med antalet insignaler.
+*                   Samtliga sådana filer måste markeras som ogiltiga.
+*
+*                   I Windows, kompilera koden och skapa en körbar fil binary_check.exe med
+*                   följande kommando:
+*                   $ g++ binary_check.cpp binary_data.cpp mapped_file.cpp text_parser.cpp -o binary_check.exe -Wall -std=c++17
+*
+*                   Kör sedan programmet med följande kommando:
+*                   $ binary_check.exe
+**************************************************************************************************/
+#include "binary_data.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+/**************************************************************************************************
+* write_corrupt: Skriver en kopia av angiven binär fil där huvudet har ändrats via angiven
+*                funktion och returnerar ifall binary_reader markerar kopian som giltig.
+*
+*                - data  : Innehållet i den giltiga binära filen.
+*                - path  : Filsökvägen där kopian skall skapas.
+*                - modify: Funktion som ändrar huvudet för kopian.
+**************************************************************************************************/
+template <typename Modify>
+static bool write_corrupt(const std::vector<char>& data,
+                          const char* path,
+                          Modify&& modify)
+{
+   binary_header header;
+   std::memcpy(&header, data.data(), sizeof(header));
+   modify(header);
+
+   std::ofstream ofstream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+   ofstream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+   ofstream.write(data.data() + sizeof(header), static_cast<std::streamsize>(data.size() - sizeof(header)));
+   ofstream.close();
+   return binary_reader(path).is_valid();
+}
+
+/**************************************************************************************************
+* main: Skapar en giltig binär fil och kontrollerar att denna kan läsas, varefter ett antal
+*       skadade huvuden kontrolleras. Ifall samtliga kontroller lyckas returneras 0, annars 1.
+**************************************************************************************************/
+int main(void)
+{
+   const char* text_path = "binary_check.txt";
+   const char* binary_path = "binary_check.bin";
+   const char* corrupt_path = "binary_check_corrupt.bin";
+   auto ok = true;
+
+   std::ofstream text(text_path);
+   for (int i = 0; i < 100; ++i) text << i << " " << -i << " " << 2 * i << "\n";
+   text.close();
+
+   if (!convert_text_to_binary(text_path, binary_path, 2))
+   {
+      std::cerr << "Could not create " << binary_path << "!\n";
+      return 1;
+   }
+
+   std::ifstream fstream(binary_path, std::ios::in | std::ios::binary);
+   const std::vector<char> data((std::istreambuf_iterator<char>(fstream)),
+                                std::istreambuf_iterator<char>());
+   fstream.close();
+
+   {
+      const binary_reader reader(binary_path);
+      double value = 0;
+      if (reader.is_valid()) reader.read_column(2, 99, 1, &value);
+
+      if (!reader.is_valid() || reader.num_rows() != 100 || value != 198)
+      {
+         std::cerr << "Valid file was not read correctly!\n";
+         ok = false;
+      }
+   }
+
+   auto reject = [&](const char* name, auto&& modify)
+   {
+      if (!write_corrupt(data, corrupt_path, modify)) return;
+      std::cerr << name << ": corrupt header accepted!\n";
+      ok = false;
+   };
+
+   reject("Wrapping column stride", [](binary_header& header)
+   {
+      header.column_stride = std::uint64_t{ 1 } << 63;
+   });
+   reject("Column stride beyond file", [](binary_header& header)
+   {
+      header.column_stride = 4096;
+   });
+   reject("Huge data offset", [](binary_header& header)
+   {
+      header.data_offset = ~std::uint64_t{ 0 } - 63;
+   });
+   reject("Too many features", [](binary_header& header)
+   {
+      header.num_features = 3;
+   });
+   reject("Too many rows", [](binary_header& header)
+   {
+      header.num_rows = 101;
+   });
+
+   std::remove(text_path);
+   std::remove(binary_path);
+   std::remove(corrupt_path);
+
+   std::cout << (ok ? "Corrupt binary headers are rejected!\n" : "Binary checks failed!\n");
+   return ok ? 0 : 1;
+}
@@ -0,0 +1,217 @@
+/**************************************************************************************************
+* binary_data.cpp: Innehåller funktionalitet för omvandling av träningsdata i textformat till 
+*                  ett binärt kolumnformat samt läsning av sådana filer via klassen 
+*                  binary_reader.
+**************************************************************************************************/
+#include "binary_data.hpp"
+#include "text_parser.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+/* Statiska konstanter: */
+static constexpr std::size_t convert_block_rows = 65536; /* Antal rader per skrivning vid omvandling. */
+
+/* Statiska funktioner: */
+static std::size_t dtype_size(const binary_dtype dtype);
+
+/**************************************************************************************************
+* binary_reader: Konstruktor för klassen binary_reader, som mappar in filen på angiven 
+*                filsökväg och validerar dess huvud. Ifall filen inte kan öppnas, har fel 
+*                format eller är för liten för angivet antal rader markeras den som ogiltig, 
+*                vilket kan kontrolleras via medlemsfunktionen is_valid. Samtliga positioner 
+*                i huvudet begränsas till filens storlek innan de multipliceras, vilket gör 
+*                att ett skadat huvud inte kan ge upphov till spill och därmed läsning 
+*                utanför den mappade filen.
+*
+*                - filepath: Filsökvägen till den binära filen.
+**************************************************************************************************/
+binary_reader::binary_reader(const std::string& filepath)
+   : m_file(filepath)
+{
+   if (!m_file.is_open() || m_file.size() < sizeof(binary_header)) return;
+   std::memcpy(&m_header, m_file.data(), sizeof(binary_header));
+
+   const auto element_size = dtype_size(m_header.dtype);
+   if (std::memcmp(m_header.magic, "LRBD", 4) != 0 || m_header.version != 1) return;
+   if (element_size == 0 || m_header.num_features == 0) return;
+   if (m_header.num_rows > m_file.size() || m_header.num_features > m_file.size()) return;
+   if (m_header.data_offset < sizeof(binary_header) || m_header.data_offset % 64 != 0) return;
+   if (m_header.data_offset > m_file.size() || m_header.column_stride > m_file.size()) return;
+
+   const auto column_size = m_header.num_rows * element_size;
+   const auto available = m_file.size() - m_header.data_offset;
+   if (m_header.column_stride < column_size || column_size > available) return;
+
+   m_valid = m_header.column_stride == 0 || 
+             m_header.num_features <= (available - column_size) / m_header.column_stride;
+   return;
+}
+
+/**************************************************************************************************
+* column: Returnerar en pekare till början av kolumnen med angivet index direkt i den mappade 
+*         filen. Kolumnerna för insignalerna har index [0, num_features()) och kolumnen för 
+*         utsignalerna har index num_features(). Elementens typ avgörs av dtype().
+*
+*         - index: Kolumnens index.
+**************************************************************************************************/
+const void* binary_reader::column(const std::size_t index) const
+{
+   return m_file.data() + m_header.data_offset + index * m_header.column_stride;
+}
+
+/**************************************************************************************************
+* read_column: Kopierar angivet antal element från kolumnen med angivet index till angiven 
+*              array. Kolumner med flyttal av dubbel precision kopieras direkt, medan flyttal 
+*              av enkel precision typomvandlas.
+*
+*              - index    : Kolumnens index.
+*              - first_row: Index för den första raden som skall kopieras.
+*              - num_rows : Antalet rader som skall kopieras.
+*              - output   : Array där kopierade element skall lagras.
+**************************************************************************************************/
+void binary_reader::read_column(const std::size_t index, 
+                                const std::size_t first_row,
+                                const std::size_t num_rows,
+                                double* output) const
+{
+   if (m_header.dtype == binary_dtype::float64)
+   {
+      std::memcpy(output, static_cast<const double*>(column(index)) + first_row, 
+                  num_rows * sizeof(double));
+   }
+   else
+   {
+      const auto* input = static_cast<const float*>(column(index)) + first_row;
+
+      for (std::size_t i = 0; i < num_rows; ++i)
+      {
+         output[i] = input[i];
+      }
+   }
+   return;
+}
+
+/**************************************************************************************************
+* convert_text_to_binary: Omvandlar träningsdata i textformat till det binära kolumnformatet. 
+*                         Textfilen mappas in i minnet och tolkas två gånger: först för att 
+*                         räkna antalet giltiga rader, så att kolumnernas positioner kan 
+*                         beräknas, och sedan för att skriva kolumnerna. Raderna samlas i block 
+*                         om convert_block_rows rader per kolumn, vilka skrivs till sina 
+*                         respektive positioner i filen. Minnesåtgången är därmed oberoende av 
+*                         filens storlek. Enbart rader med exakt num_features insignaler följt 
+*                         av en utsignal lagras. Vid lyckad omvandling returneras true.
+*
+*                         - text_path   : Filsökvägen till textfilen.
+*                         - binary_path : Filsökvägen till den binära fil som skall skapas.
+*                         - num_features: Antalet insignaler per rad (default = 1).
+*                         - dtype       : Datatyp för kolumnerna (default = float64).
+**************************************************************************************************/
+bool convert_text_to_binary(const std::string& text_path,
+                            const std::string& binary_path,
+                            const std::size_t num_features,
+                            const binary_dtype dtype)
+{
+   const mapped_file text(text_path);
+
+   if (!text.is_open())
+   {
+      std::cerr << "Could not open file at path " << text_path << "!\n\n";
+      return false;
+   }
+
+   const auto num_cols = num_features + 1;
+   const auto element_size = dtype_size(dtype);
+   const auto* end = text.data() + text.size();
+   std::vector<double> values(num_cols);
+   std::size_t num_rows = 0;
+   std::size_t num_failures = 0;
+
+   if (num_features == 0 || element_size == 0) return false;
+
+   for (auto* i = text.data(); i < end;)
+   {
+      const auto* line_end = find_line_end(i, end);
+      if (parse_numbers(i, line_end, values.data(), num_cols, num_failures) == num_cols) num_rows++;
+      i = next_line(line_end, end);
+   }
+
+   binary_header header;
+   header.dtype = dtype;
+   header.num_features = static_cast<std::uint32_t>(num_features);
+   header.num_rows = num_rows;
+   header.column_stride = (num_rows * element_size + 63) / 64 * 64;
+
+   std::ofstream ofstream(binary_path, std::ios::out | std::ios::binary | std::ios::trunc);
+
+   if (!ofstream)
+   {
+      std::cerr << "Could not open file at path " << binary_path << "!\n\n";
+      return false;
+   }
+
+   ofstream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+   std::vector<char> block(num_cols * convert_block_rows * element_size);
+   std::size_t first_row = 0;
+   std::size_t num_buffered = 0;
+
+   auto flush = [&](void)
+   {
+      for (std::size_t i = 0; i < num_cols; ++i)
+      {
+         ofstream.seekp(static_cast<std::streamoff>(header.data_offset + i * header.column_stride + 
+                                                    first_row * element_size));
+         ofstream.write(&block[i * convert_block_rows * element_size], 
+                        static_cast<std::streamsize>(num_buffered * element_size));
+      }
+
+      first_row += num_buffered;
+      num_buffered = 0;
+   };
+
+   for (auto* i = text.data(); i < end;)
+   {
+      const auto* line_end = find_line_end(i, end);
+
+      if (parse_numbers(i, line_end, values.data(), num_cols, num_failures) == num_cols)
+      {
+         for (std::size_t j = 0; j < num_cols; ++j)
+         {
+            auto* destination = &block[(j * convert_block_rows + num_buffered) * element_size];
+
+            if (dtype == binary_dtype::float64)
+            {
+               std::memcpy(destination, &values[j], sizeof(double));
+            }
+            else
+            {
+               const auto value = static_cast<float>(values[j]);
+               std::memcpy(destination, &value, sizeof(float));
+            }
+         }
+
+         if (++num_buffered == convert_block_rows) flush();
+      }
+
+      i = next_line(line_end, end);
+   }
+
+   if (num_buffered > 0) flush();
+   return static_cast<bool>(ofstream);
+}
+
+/**************************************************************************************************
+* dtype_size: Returnerar storleken i byte för ett element av angiven datatyp, eller noll ifall 
+*             datatypen är okänd.
+*
+*             - dtype: Den datatyp vars storlek skall returneras.
+**************************************************************************************************/
+static std::size_t dtype_size(const binary_dtype dtype)
+{
+   if (dtype == binary_dtype::float64) return sizeof(double);
+   if (dtype == binary_dtype::float32) return sizeof(float);
+   return 0;
+}
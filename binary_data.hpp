@@ -0,0 +1,86 @@
+/**************************************************************************************************
+* binary_data.hpp: Innehåller funktionalitet för ett kompakt binärt kolumnformat för träningsdata, 
+*                  vilket kan läsas in utan att text behöver tolkas. Filer i textformat kan 
+*                  omvandlas till binärformatet via funktionen convert_text_to_binary och läsas 
+*                  via klassen binary_reader.
+*
+*                  Formatet består av ett huvud om 64 byte följt av en kolumn per insignal samt 
+*                  en kolumn för utsignalerna. Varje kolumn lagras sammanhängande och börjar på 
+*                  en adress som är jämnt delbar med 64 byte. Samtliga tal lagras i 
+*                  datorns egen byteordning, eftersom kolumnerna läses direkt ur den mappade 
+*                  filen, vilket gör att filerna enbart kan läsas på datorer med samma 
+*                  byteordning som datorn som skapade dem.
+**************************************************************************************************/
+#ifndef BINARY_DATA_HPP_
+#define BINARY_DATA_HPP_
+
+/* Inkluderingsdirektiv: */
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "mapped_file.hpp"
+
+/* Datatyper för kolumnerna: */
+enum class binary_dtype : std::uint32_t
+{
+   float64 = 0, /* Flyttal med dubbel precision (double). */
+   float32 = 1  /* Flyttal med enkel precision (float). */
+};
+
+/**************************************************************************************************
+* binary_header: Huvud för binära filer med träningsdata, som lagras först i filen.
+**************************************************************************************************/
+struct binary_header
+{
+   char magic[4] = { 'L', 'R', 'B', 'D' }; /* Identifierar filformatet. */
+   std::uint32_t version = 1;              /* Formatets version. */
+   binary_dtype dtype = binary_dtype::float64; /* Datatyp för kolumnerna. */
+   std::uint32_t num_features = 1;         /* Antalet insignaler per träningsuppsättning. */
+   std::uint64_t num_rows = 0;             /* Antalet träningsuppsättningar. */
+   std::uint64_t data_offset = 64;         /* Position för den första kolumnen i byte. */
+   std::uint64_t column_stride = 0;        /* Avstånd mellan kolumnernas början i byte. */
+   std::uint8_t reserved[24] = { };        /* Reserverat för framtida versioner. */
+};
+
+static_assert(sizeof(binary_header) == 64, "binary_header must be 64 bytes");
+
+/**************************************************************************************************
+* binary_reader: Klass för läsning av binära filer med träningsdata. Filen mappas in i minnet 
+*                och huvudet valideras vid öppning, varefter kolumnerna kan läsas direkt ur 
+*                den mappade filen. Kolumnen för utsignalerna har index num_features().
+**************************************************************************************************/
+class binary_reader
+{
+protected:
+   /* Medlemmar: */
+   mapped_file m_file;     /* Den mappade filen. */
+   binary_header m_header; /* Filens huvud. */
+   bool m_valid = false;   /* Indikerar ifall filen är öppen och giltig. */
+
+public:
+   binary_reader(const std::string& filepath);
+   ~binary_reader(void) { }
+   binary_reader(binary_reader&) = delete;
+   binary_reader& operator = (binary_reader&) = delete;
+
+   bool is_valid(void) const { return m_valid; }
+   std::size_t num_rows(void) const { return static_cast<std::size_t>(m_header.num_rows); }
+   std::size_t num_features(void) const { return m_header.num_features; }
+   binary_dtype dtype(void) const { return m_header.dtype; }
+   std::size_t size(void) const { return m_file.size(); }
+
+   const void* column(const std::size_t index) const;
+   void read_column(const std::size_t index, 
+                    const std::size_t first_row,
+                    const std::size_t num_rows,
+                    double* output) const;
+};
+
+/* Funktionsdeklarationer: */
+bool convert_text_to_binary(const std::string& text_path,
+                            const std::string& binary_path,
+                            const std::size_t num_features = 1,
+                            const binary_dtype dtype = binary_dtype::float64);
+
+#endif /* BINARY_DATA_HPP_ */
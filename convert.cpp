@@ -0,0 +1,35 @@
+/**************************************************************************************************
+* convert.cpp: Omvandlar träningsdata i textformat till det binära kolumnformatet, vilket 
+*              därefter kan läsas in via medlemsfunktionen load_binary_data utan att text 
+*              behöver tolkas.
+*
+*              I Windows, kompilera koden och skapa en körbar fil convert.exe med följande kommando:
+*              $ g++ convert.cpp binary_data.cpp mapped_file.cpp text_parser.cpp -o convert.exe -Wall -std=c++17
+*
+*              Kör sedan programmet med följande kommando, där antalet insignaler per rad samt 
+*              flaggan float32 (för flyttal med enkel precision) är valfria:
+*              $ convert.exe data.txt data.bin [num_features] [float32]
+**************************************************************************************************/
+#include "binary_data.hpp"
+
+#include <iostream>
+#include <string>
+
+/**************************************************************************************************
+* main: Läser filsökvägar, antalet insignaler samt datatyp från kommandoraden och omvandlar 
+*       angiven textfil till en binär fil. Vid lyckad omvandling returneras 0, annars 1.
+**************************************************************************************************/
+int main(int argc, char** argv)
+{
+   if (argc < 3)
+   {
+      std::cerr << "Usage: " << argv[0] << " <text file> <binary file> [num_features] [float32]\n";
+      return 1;
+   }
+
+   const auto num_features = argc > 3 ? std::stoul(argv[3]) : 1;
+   const auto dtype = argc > 4 && std::string(argv[4]) == "float32" ? 
+      binary_dtype::float32 : binary_dtype::float64;
+
+   return convert_text_to_binary(argv[1], argv[2], num_features, dtype) ? 0 : 1;
+}
@@ -0,0 +1,367 @@
+/**************************************************************************************************
+* feature_matrix.hpp: Innehåller klassmallen feature_matrix, som lagrar insignaler för
+*                     träningsdata med flera insignaler per träningsuppsättning i en
+*                     sammanhängande matris, där lagringsordningen anges vid kompilering.
+**************************************************************************************************/
+#ifndef FEATURE_MATRIX_HPP_
+#define FEATURE_MATRIX_HPP_
+
+/* Inkluderingsdirektiv: */
+#include <cstddef>
+#include <memory_resource>
+#include <utility>
+
+#include "aligned_allocator.hpp"
+
+/* Lagringsordning för matrisens element: */
+enum class matrix_layout
+{
+   row_major,   /* Radvis lagring, en träningsuppsättnings insignaler ligger intill varandra. */
+   column_major /* Kolumnvis lagring, en insignal ligger intill varandra för samtliga rader. */
+};
+
+/**************************************************************************************************
+* feature_matrix: Klassmall för en sammanhängande matris av flyttal av typen T med en rad per
+*                 träningsuppsättning och en kolumn per insignal, där Layout anger
+*                 lagringsordningen. Minnet justeras efter cacheline via aligned_allocator och
+*                 hämtas från en minnesresurs (std::pmr) som kan anges vid konstruktion.
+*
+*                 Vid radvis lagring (matrix_layout::row_major), som är default, ligger samtliga
+*                 insignaler för en träningsuppsättning intill varandra i minnet, vilket
+*                 lämpar sig för stokastisk gradientnedstigning samt prediktion. Matrisen
+*                 fungerar då som en vektor med num_rows * num_cols element, där nya rader
+*                 läggs till sist. Vid kolumnvis lagring (matrix_layout::column_major) ligger
+*                 i stället varje insignal sammanhängande för samtliga träningsuppsättningar,
+*                 där plats reserveras för m_capacity rader per kolumn, så att nya rader kan
+*                 läggas till utan att befintliga kolumner flyttas.
+*
+*                 Eftersom lagringsordningen är en mallparameter avgörs positionen för varje
+*                 element vid kompilering, utan förgrening vid varje åtkomst. En rad respektive
+*                 kolumn nås via en pekare till det första elementet samt avståndet mellan två
+*                 efterföljande element, som är ett för rader vid radvis lagring samt för
+*                 kolumner vid kolumnvis lagring.
+**************************************************************************************************/
+template <typename T, matrix_layout Layout = matrix_layout::row_major>
+class feature_matrix
+{
+protected:
+   /* Statiska konstanter: */
+   static constexpr bool is_column_major = Layout == matrix_layout::column_major;
+
+   /* Medlemmar: */
+   aligned_vector<T> m_data;   /* Matrisens element. */
+   std::size_t m_num_rows = 0; /* Antalet rader (träningsuppsättningar). */
+   std::size_t m_num_cols = 0; /* Antalet kolumner (insignaler). */
+   std::size_t m_capacity = 0; /* Antalet rader per kolumn vid kolumnvis lagring. */
+
+   /**********************************************************************************************
+   * offset: Returnerar positionen i m_data för elementet på angiven rad och kolumn.
+   *
+   *         - row: Radens index.
+   *         - col: Kolumnens index.
+   **********************************************************************************************/
+   std::size_t offset(const std::size_t row,
+                      const std::size_t col) const
+   {
+      if constexpr (is_column_major)
+      {
+         return col * m_capacity + row;
+      }
+      else
+      {
+         return row * m_num_cols + col;
+      }
+   }
+
+public:
+   /**********************************************************************************************
+   * feature_matrix: Konstruktor, som initierar en tom matris med angivet antal kolumner, vars
+   *                 minne hämtas från angiven minnesresurs.
+   *
+   *                 - num_cols: Antalet kolumner (default = 0).
+   *                 - resource: Minnesresurs för matrisens element (default =
+   *                             std::pmr::get_default_resource()).
+   **********************************************************************************************/
+   explicit feature_matrix(const std::size_t num_cols = 0,
+                           std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : m_data(resource),
+        m_num_cols(num_cols) { }
+
+   ~feature_matrix(void) { }
+   feature_matrix(feature_matrix&) = delete;
+   feature_matrix& operator = (feature_matrix&) = delete;
+
+   /**********************************************************************************************
+   * feature_matrix: Förflyttningskonstruktor, som medför förflyttning av minne från source till
+   *                 angivet objekt this. Efter förflyttningen är source tom.
+   *
+   *                 - source: Den matris som minnet skall förflyttas från.
+   **********************************************************************************************/
+   feature_matrix(feature_matrix&& source) noexcept
+      : m_data(std::move(source.m_data)),
+        m_num_rows(source.m_num_rows),
+        m_num_cols(source.m_num_cols),
+        m_capacity(source.m_capacity)
+   {
+      source.m_data.clear();
+      source.m_num_rows = 0;
+      source.m_capacity = 0;
+      return;
+   }
+
+   /**********************************************************************************************
+   * operator =: Förflyttar innehållet i matrisen source till angivet objekt this, varefter
+   *             source töms. Angiven matris behåller sin minnesresurs, vilket gör att
+   *             elementen kopieras ifall matriserna använder olika minnesresurser.
+   *
+   *             - source: Den matris som minnet skall förflyttas från.
+   **********************************************************************************************/
+   feature_matrix& operator = (feature_matrix&& source)
+   {
+      if (this != &source)
+      {
+         m_data = std::move(source.m_data);
+         m_num_rows = source.m_num_rows;
+         m_num_cols = source.m_num_cols;
+         m_capacity = source.m_capacity;
+         source.m_data.clear();
+         source.m_num_rows = 0;
+         source.m_capacity = 0;
+      }
+      return *this;
+   }
+
+   static constexpr matrix_layout layout(void) { return Layout; }
+   std::size_t rows(void) const { return m_num_rows; }
+   std::size_t cols(void) const { return m_num_cols; }
+   std::size_t size(void) const { return m_num_rows * m_num_cols; }
+   std::size_t row_stride(void) const { return is_column_major ? m_capacity : 1; }
+   std::size_t column_stride(void) const { return is_column_major ? 1 : m_num_cols; }
+   std::pmr::memory_resource* resource(void) const { return m_data.get_allocator().resource(); }
+
+   /**********************************************************************************************
+   * data: Returnerar en pekare till det första elementet i lagringsordningen. Vid radvis
+   *       lagring ligger size() element efter varandra, medan kolumnerna vid kolumnvis lagring
+   *       börjar row_stride() element ifrån varandra.
+   **********************************************************************************************/
+   T* data(void) { return m_data.data(); }
+   const T* data(void) const { return m_data.data(); }
+
+   /**********************************************************************************************
+   * operator[]: Returnerar en referens till elementet på angiven position i lagringsordningen,
+   *             vilket vid en kolumn motsvarar raden med samma index oavsett lagringsordning.
+   *
+   *             - index: Elementets position i lagringsordningen.
+   **********************************************************************************************/
+   T& operator [] (const std::size_t index) { return m_data[index]; }
+   const T& operator [] (const std::size_t index) const { return m_data[index]; }
+
+   /**********************************************************************************************
+   * at: Returnerar en referens till elementet på angiven rad och kolumn.
+   *
+   *     - row: Radens index.
+   *     - col: Kolumnens index.
+   **********************************************************************************************/
+   T& at(const std::size_t row,
+         const std::size_t col)
+   {
+      return m_data[offset(row, col)];
+   }
+
+   const T& at(const std::size_t row,
+               const std::size_t col) const
+   {
+      return m_data[offset(row, col)];
+   }
+
+   /**********************************************************************************************
+   * row: Returnerar en pekare till det första elementet på angiven rad, där efterföljande
+   *      element ligger row_stride() element ifrån varandra.
+   *
+   *      - row: Radens index.
+   **********************************************************************************************/
+   const T* row(const std::size_t row) const { return m_data.data() + offset(row, 0); }
+
+   /**********************************************************************************************
+   * column: Returnerar en pekare till det första elementet i angiven kolumn, där efterföljande
+   *         element ligger column_stride() element ifrån varandra.
+   *
+   *         - col: Kolumnens index.
+   **********************************************************************************************/
+   const T* column(const std::size_t col) const { return m_data.data() + offset(0, col); }
+
+   /**********************************************************************************************
+   * clear: Tömmer matrisen. Antalet kolumner samt allokerat minne behålls, så att matrisen kan
+   *        fyllas på nytt utan allokering.
+   **********************************************************************************************/
+   void clear(void)
+   {
+      if constexpr (!is_column_major) m_data.clear();
+      m_num_rows = 0;
+      return;
+   }
+
+   /**********************************************************************************************
+   * reset: Tömmer matrisen och sätter nytt antal kolumner.
+   *
+   *        - num_cols: Det nya antalet kolumner (insignaler per träningsuppsättning).
+   **********************************************************************************************/
+   void reset(const std::size_t num_cols)
+   {
+      m_data.clear();
+      m_num_rows = 0;
+      m_num_cols = num_cols;
+      m_capacity = 0;
+      return;
+   }
+
+   /**********************************************************************************************
+   * reserve: Reserverar plats för angivet antal rader, så att rader kan läggas till utan att
+   *          matrisen allokeras om. Vid kolumnvis lagring flyttas befintliga kolumner till sina
+   *          nya positioner, där den nya matrisen allokeras från samma minnesresurs.
+   *
+   *          - num_rows: Det antal rader som det skall finnas plats för.
+   **********************************************************************************************/
+   void reserve(const std::size_t num_rows)
+   {
+      if constexpr (is_column_major)
+      {
+         if (num_rows <= m_capacity) return;
+         aligned_vector<T> data(num_rows * m_num_cols, T(0), m_data.get_allocator());
+
+         for (std::size_t i = 0; i < m_num_cols; ++i)
+         {
+            for (std::size_t j = 0; j < m_num_rows; ++j)
+            {
+               data[i * num_rows + j] = m_data[i * m_capacity + j];
+            }
+         }
+
+         m_data.swap(data);
+         m_capacity = num_rows;
+      }
+      else
+      {
+         m_data.reserve(num_rows * m_num_cols);
+      }
+      return;
+   }
+
+   /**********************************************************************************************
+   * resize: Sätter antalet rader i matrisen. Nya rader nollställs.
+   *
+   *         - num_rows: Det nya antalet rader.
+   **********************************************************************************************/
+   void resize(const std::size_t num_rows)
+   {
+      if constexpr (is_column_major)
+      {
+         reserve(num_rows);
+
+         for (std::size_t i = 0; i < m_num_cols; ++i)
+         {
+            for (auto j = m_num_rows; j < num_rows; ++j)
+            {
+               m_data[i * m_capacity + j] = 0;
+            }
+         }
+      }
+      else
+      {
+         m_data.resize(num_rows * m_num_cols);
+      }
+
+      m_num_rows = num_rows;
+      return;
+   }
+
+   /**********************************************************************************************
+   * append_row: Lägger till en rad sist i matrisen, där angivna värden typomvandlas till T.
+   *             Ifall plats saknas fördubblas kapaciteten, vilket ger amorterat konstant tid
+   *             per rad.
+   *
+   *             - values: Array innehållande ett värde per kolumn för den nya raden.
+   **********************************************************************************************/
+   template <typename U>
+   void append_row(const U* values)
+   {
+      if constexpr (is_column_major)
+      {
+         if (m_num_rows == m_capacity) reserve(m_capacity > 0 ? 2 * m_capacity : 16);
+
+         for (std::size_t i = 0; i < m_num_cols; ++i)
+         {
+            m_data[i * m_capacity + m_num_rows] = static_cast<T>(values[i]);
+         }
+      }
+      else
+      {
+         for (std::size_t i = 0; i < m_num_cols; ++i)
+         {
+            m_data.push_back(static_cast<T>(values[i]));
+         }
+      }
+
+      m_num_rows++;
+      return;
+   }
+
+   /**********************************************************************************************
+   * assign: Ersätter matrisens innehåll med angivet antal rader ur arrayen values, där
+   *         värdena lagras radvis. Vid kolumnvis lagring sorteras värdena om kolumn för kolumn.
+   *
+   *         - values  : Array innehållande num_rows * cols() värden lagrade radvis.
+   *         - num_rows: Antalet rader.
+   **********************************************************************************************/
+   void assign(const T* values,
+               const std::size_t num_rows)
+   {
+      if constexpr (is_column_major)
+      {
+         m_num_rows = 0;
+         reserve(num_rows);
+
+         for (std::size_t i = 0; i < m_num_cols; ++i)
+         {
+            for (std::size_t j = 0; j < num_rows; ++j)
+            {
+               m_data[i * m_capacity + j] = values[j * m_num_cols + i];
+            }
+         }
+      }
+      else
+      {
+         m_data.assign(values, values + num_rows * m_num_cols);
+      }
+
+      m_num_rows = num_rows;
+      return;
+   }
+
+   /**********************************************************************************************
+   * assign: Tar över refererad vektor innehållande minst num_rows * cols() värden lagrade
+   *         radvis som matrisens innehåll. Vid radvis lagring förflyttas vektorns minne, vilket
+   *         inte medför någon kopiering ifall vektorn använder samma minnesresurs som matrisen.
+   *         Vid kolumnvis lagring kopieras värdena i stället kolumn för kolumn.
+   *
+   *         - values  : Vektor innehållande värden lagrade radvis.
+   *         - num_rows: Antalet rader.
+   **********************************************************************************************/
+   void assign(aligned_vector<T>&& values,
+               const std::size_t num_rows)
+   {
+      if constexpr (is_column_major)
+      {
+         assign(values.data(), num_rows);
+      }
+      else
+      {
+         m_data = std::move(values);
+         m_data.resize(num_rows * m_num_cols);
+         m_num_rows = num_rows;
+      }
+      return;
+   }
+};
+
+#endif /* FEATURE_MATRIX_HPP_ */
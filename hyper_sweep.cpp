@@ -0,0 +1,356 @@
+/**************************************************************************************************
+* hyper_sweep.cpp: Innehåller medlemsfunktioner tillhörande klassen hyper_sweep, vilket används
+*                  för parallell sökning efter hyperparametrar via k-faldig korsvalidering.
+**************************************************************************************************/
+#include "hyper_sweep.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+/**************************************************************************************************
+* fold_result: Resultat för en enskild kombination av konfiguration och veck.
+**************************************************************************************************/
+struct fold_result
+{
+   double validation_loss = 0; /* Valideringsförlust för vecket. */
+   double training_loss = 0;   /* Träningsförlust under sista genomförda epoken. */
+   std::size_t epochs_run = 0; /* Antalet genomförda epoker. */
+   double weight = 0;          /* Tränad lutning. */
+   double bias = 0;            /* Tränat vilovärde. */
+};
+
+/**************************************************************************************************
+* load_training_data: Läser in träningsdata från en textfil, se lin_reg::load_training_data.
+*                     Datan läses in en gång och delas därefter av samtliga modeller.
+*
+*                     - filepath: Filsökvägen till träningsdatan.
+**************************************************************************************************/
+load_stats hyper_sweep::load_training_data(const std::string& filepath)
+{
+   return m_dataset.load_training_data(filepath);
+}
+
+/**************************************************************************************************
+* load_binary_data: Läser in träningsdata från en binär fil, se lin_reg::load_binary_data.
+*
+*                   - filepath: Filsökvägen till träningsdatan.
+**************************************************************************************************/
+load_stats hyper_sweep::load_binary_data(const std::string& filepath)
+{
+   return m_dataset.load_binary_data(filepath);
+}
+
+/**************************************************************************************************
+* set_training_data: Kopierar träningsdata från angivna vektorer, se lin_reg::set_training_data.
+*
+*                    - train_in : Insignaler för träningsuppsättningarna.
+*                    - train_out: Utsignaler för träningsuppsättningarna.
+**************************************************************************************************/
+void hyper_sweep::set_training_data(const std::vector<double>& train_in,
+                                    const std::vector<double>& train_out)
+{
+   m_dataset.set_training_data(train_in, train_out);
+   return;
+}
+
+/**************************************************************************************************
+* add_config: Lägger till angiven konfiguration bland de konfigurationer som skall utvärderas.
+*
+*             - config: Konfigurationen som skall läggas till.
+**************************************************************************************************/
+void hyper_sweep::add_config(const sweep_config& config)
+{
+   m_configs.push_back(config);
+   return;
+}
+
+/**************************************************************************************************
+* add_grid: Lägger till en konfiguration för varje kombination av angivna lärhastigheter samt
+*           antal epoker, där samtliga konfigurationer använder angiven batchstorlek samt metod
+*           för justering av parametrarna.
+*
+*           - learning_rates: Lärhastigheter som skall utvärderas.
+*           - epochs        : Antal epoker som skall utvärderas.
+*           - batch_size    : Antalet träningsuppsättningar per minibatch (default = 1).
+*           - optimizer     : Metod för justering (default = optimizer_mode::sgd).
+**************************************************************************************************/
+void hyper_sweep::add_grid(const std::vector<double>& learning_rates,
+                           const std::vector<std::size_t>& epochs,
+                           const std::size_t batch_size,
+                           const optimizer_mode optimizer)
+{
+   for (const auto learning_rate : learning_rates)
+   {
+      for (const auto num_epochs : epochs)
+      {
+         sweep_config config;
+         config.learning_rate = learning_rate;
+         config.num_epochs = num_epochs;
+         config.batch_size = batch_size;
+         config.optimizer = optimizer;
+         m_configs.push_back(config);
+      }
+   }
+   return;
+}
+
+/**************************************************************************************************
+* clear_configs: Tar bort samtliga konfigurationer samt resultat från föregående sökning.
+**************************************************************************************************/
+void hyper_sweep::clear_configs(void)
+{
+   m_configs.clear();
+   m_results.clear();
+   return;
+}
+
+/**************************************************************************************************
+* set_folds: Sätter antalet veck vid korsvalidering ifall angivet nytt värde är minst två.
+*
+*            - num_folds: Det nya antalet veck.
+**************************************************************************************************/
+void hyper_sweep::set_folds(const std::size_t num_folds)
+{
+   if (num_folds >= 2)
+   {
+      m_num_folds = num_folds;
+   }
+   return;
+}
+
+/**************************************************************************************************
+* set_num_threads: Sätter antalet trådar som används vid sökningen ifall angivet nytt värde
+*                  överstiger noll. Varje modell tränas i en tråd, där flera modeller tränas
+*                  samtidigt.
+*
+*                  - num_threads: Det nya antalet trådar.
+**************************************************************************************************/
+void hyper_sweep::set_num_threads(const std::size_t num_threads)
+{
+   if (num_threads > 0)
+   {
+      m_num_threads = num_threads;
+   }
+   return;
+}
+
+/**************************************************************************************************
+* set_seed: Sätter frö för indelningen i veck samt för randomiseringen vid träningen, vilket
+*           gör att sökningen kan upprepas med identiskt resultat.
+*
+*           - seed: Det nya fröet.
+**************************************************************************************************/
+void hyper_sweep::set_seed(const std::uint64_t seed)
+{
+   m_seed = seed;
+   return;
+}
+
+/**************************************************************************************************
+* set_early_stopping: Aktiverar tidigt avbrott för samtliga modeller, se
+*                     lin_reg::set_early_stopping. Eftersom valideringsdatan utgörs av vecket
+*                     övervakas träningsförlusten.
+*
+*                     - tolerance: Tolerans för konvergens (noll = avstängd).
+*                     - patience : Antalet epoker i följd utan förbättring innan träningen
+*                                  avbryts (default = 5).
+**************************************************************************************************/
+void hyper_sweep::set_early_stopping(const double tolerance,
+                                     const std::size_t patience)
+{
+   if (tolerance >= 0)
+   {
+      m_tolerance = tolerance;
+      m_patience = patience > 0 ? patience : 1;
+   }
+   return;
+}
+
+/**************************************************************************************************
+* set_standardization: Aktiverar eller avaktiverar standardisering av insignalerna för samtliga
+*                      modeller, se lin_reg::set_standardization.
+*
+*                      - standardize: Indikerar ifall insignalerna skall standardiseras.
+**************************************************************************************************/
+void hyper_sweep::set_standardization(const bool standardize)
+{
+   m_standardize = standardize;
+   return;
+}
+
+/**************************************************************************************************
+* run: Utvärderar samtliga konfigurationer via k-faldig korsvalidering och returnerar
+*      resultaten rangordnade efter genomsnittlig valideringsförlust, lägst först.
+*
+*      Träningsuppsättningarna randomiseras först en gång och delas in i sammanhängande veck
+*      av randomiseringen. Varje deluppgift bildar sin träningsdel av index för övriga veck
+*      och tränar en egen modell via lin_reg::train_indexed direkt på den delade
+*      träningsdatan, varefter valideringsförlusten beräknas för vecket. Deluppgifterna
+*      exekveras i fallande ordning efter antalet epoker, så att de längsta träningarna inte
+*      startas sist. Varje deluppgift skriver enbart till sin egen plats i resultatvektorn.
+*
+*      Konfigurationer vars träning har divergerat, vilket ger en ogiltig valideringsförlust, 
+*      placeras sist. Ifall inga konfigurationer har lagts till eller ifall träningsdatan
+*      innehåller färre än två träningsuppsättningar returneras en tom vektor. Antalet veck
+*      begränsas till antalet träningsuppsättningar.
+**************************************************************************************************/
+const std::vector<sweep_result>& hyper_sweep::run(void)
+{
+   const auto& train_in = m_dataset.training_inputs();
+   const auto& train_out = m_dataset.training_outputs();
+   const auto num_sets = train_in.size();
+   const auto num_folds = m_num_folds < num_sets ? m_num_folds : num_sets;
+
+   m_results.clear();
+   if (m_configs.empty() || num_sets < 2) return m_results;
+
+   m_permutation.resize(num_sets);
+
+   for (std::size_t i = 0; i < num_sets; ++i)
+   {
+      m_permutation[i] = i;
+   }
+
+   shuffler(m_seed).shuffle(m_permutation);
+
+   const auto num_tasks = m_configs.size() * num_folds;
+   std::vector<fold_result> fold_results(num_tasks);
+   std::vector<std::size_t> schedule(num_tasks);
+
+   for (std::size_t i = 0; i < num_tasks; ++i)
+   {
+      schedule[i] = i;
+   }
+
+   std::stable_sort(schedule.begin(), schedule.end(), [&](const std::size_t a, const std::size_t b)
+   {
+      return m_configs[a / num_folds].num_epochs > m_configs[b / num_folds].num_epochs;
+   });
+
+   auto train_fold = [&](const std::size_t i)
+   {
+      const auto task = schedule[i];
+      const auto& config = m_configs[task / num_folds];
+      const auto fold = task % num_folds;
+      const auto first = fold * num_sets / num_folds;
+      const auto last = (fold + 1) * num_sets / num_folds;
+
+      std::vector<std::size_t> order;
+      order.reserve(num_sets - (last - first));
+      order.insert(order.end(), m_permutation.begin(), m_permutation.begin() + first);
+      order.insert(order.end(), m_permutation.begin() + last, m_permutation.end());
+
+      lin_reg model(config.num_epochs, config.learning_rate);
+      model.set_batch_size(config.batch_size);
+      model.set_optimizer(config.optimizer);
+      model.set_schedule(config.schedule);
+      model.set_early_stopping(m_tolerance, m_patience);
+      model.set_standardization(m_standardize);
+      model.set_seed(m_seed + fold + 1);
+      model.train_indexed(train_in.data(), train_out.data(), order);
+
+      double sum_squared_error = 0;
+
+      for (auto k = first; k < last; ++k)
+      {
+         const auto j = m_permutation[k];
+         const auto error = train_out[j] - model.predict(train_in[j]);
+         sum_squared_error += error * error;
+      }
+
+      auto& result = fold_results[task];
+      result.validation_loss = sum_squared_error / (last - first);
+      result.training_loss = model.loss_history().empty() ? 0.0 : model.loss_history().back();
+      result.epochs_run = model.epochs_run();
+      result.weight = model.weight();
+      result.bias = model.bias();
+   };
+
+   if (m_num_threads > 1 && num_tasks > 1)
+   {
+      thread_pool pool(m_num_threads < num_tasks ? m_num_threads : num_tasks);
+      pool.run(num_tasks, train_fold);
+   }
+   else
+   {
+      for (std::size_t i = 0; i < num_tasks; ++i)
+      {
+         train_fold(i);
+      }
+   }
+
+   m_results.resize(m_configs.size());
+
+   for (std::size_t i = 0; i < m_configs.size(); ++i)
+   {
+      auto& result = m_results[i];
+      result.config = m_configs[i];
+
+      for (std::size_t j = 0; j < num_folds; ++j)
+      {
+         const auto& fold = fold_results[i * num_folds + j];
+         result.validation_loss += fold.validation_loss;
+         result.training_loss += fold.training_loss;
+         result.epochs_run += fold.epochs_run;
+         result.weight += fold.weight;
+         result.bias += fold.bias;
+      }
+
+      result.validation_loss /= num_folds;
+      result.training_loss /= num_folds;
+      result.epochs_run /= num_folds;
+      result.weight /= num_folds;
+      result.bias /= num_folds;
+
+      for (std::size_t j = 0; j < num_folds; ++j)
+      {
+         const auto deviation = fold_results[i * num_folds + j].validation_loss - result.validation_loss;
+         result.validation_stddev += deviation * deviation;
+      }
+
+      result.validation_stddev = std::sqrt(result.validation_stddev / num_folds);
+   }
+
+   std::stable_sort(m_results.begin(), m_results.end(), [](const sweep_result& a, const sweep_result& b)
+   {
+      return !std::isnan(a.validation_loss) && 
+             (std::isnan(b.validation_loss) || a.validation_loss < b.validation_loss);
+   });
+   return m_results;
+}
+
+/**************************************************************************************************
+* print_results: Skriver ut resultaten från senaste sökningen i form av en tabell, rangordnad
+*                efter genomsnittlig valideringsförlust, via angiven utström.
+*
+*                - ostream : Angiven utström (default = std::cout).
+*                - max_rows: Största antalet rader som skall skrivas ut (default = 0, vilket
+*                            innebär samtliga rader).
+**************************************************************************************************/
+void hyper_sweep::print_results(std::ostream& ostream,
+                                const std::size_t max_rows) const
+{
+   const auto num_rows = max_rows > 0 && max_rows < m_results.size() ? max_rows : m_results.size();
+   char line[256];
+
+   const auto length = std::snprintf(line, sizeof(line), "%-6s %-14s %-8s %-8s %-14s %-14s %-14s %s\n",
+                                     "Rank", "Learning rate", "Epochs", "Batch", "Val. loss", 
+                                     "Val. stddev", "Train loss", "Epochs run");
+   const std::string frame(static_cast<std::size_t>(length - 1), '-');
+   ostream << frame << "\n" << line << frame << "\n";
+
+   for (std::size_t i = 0; i < num_rows; ++i)
+   {
+      const auto& result = m_results[i];
+      std::snprintf(line, sizeof(line), "%-6zu %-14g %-8zu %-8zu %-14g %-14g %-14g %.1f\n",
+                    i + 1, result.config.learning_rate, result.config.num_epochs,
+                    result.config.batch_size, result.validation_loss, result.validation_stddev,
+                    result.training_loss, result.epochs_run);
+      ostream << line;
+   }
+
+   ostream << frame << "\n\n";
+   return;
+}
@@ -0,0 +1,111 @@
+/**************************************************************************************************
+* hyper_sweep.hpp: Innehåller funktionalitet för parallell sökning efter hyperparametrar för
+*                  regressionsmodeller via k-faldig korsvalidering med klassen hyper_sweep.
+**************************************************************************************************/
+#ifndef HYPER_SWEEP_HPP_
+#define HYPER_SWEEP_HPP_
+
+/* Inkluderingsdirektiv: */
+#include <iostream>
+#include <vector>
+#include <string>
+
+#include "lin_reg.hpp"
+
+/**************************************************************************************************
+* sweep_config: Konfiguration av hyperparametrar som skall utvärderas vid sökningen.
+**************************************************************************************************/
+struct sweep_config
+{
+   double learning_rate = 0.01;                        /* Lärhastighet. */
+   std::size_t num_epochs = 100;                       /* Antalet träningsomgångar. */
+   std::size_t batch_size = 1;                         /* Antalet träningsuppsättningar per minibatch. */
+   optimizer_mode optimizer = optimizer_mode::sgd;     /* Metod för justering av parametrarna. */
+   schedule_mode schedule = schedule_mode::constant;   /* Schema för lärhastigheten. */
+};
+
+/**************************************************************************************************
+* sweep_result: Resultat för en konfiguration, där samtliga värden utgör medelvärden över
+*               korsvalideringens veck.
+**************************************************************************************************/
+struct sweep_result
+{
+   sweep_config config;          /* Utvärderad konfiguration. */
+   double validation_loss = 0;   /* Valideringsförlust (medelkvadratfel). */
+   double validation_stddev = 0; /* Standardavvikelse för valideringsförlusten mellan vecken. */
+   double training_loss = 0;     /* Träningsförlust under sista genomförda epoken. */
+   double epochs_run = 0;        /* Antalet genomförda epoker. */
+   double weight = 0;            /* Lutning (k-värde). */
+   double bias = 0;              /* Vilovärde (m-värde). */
+};
+
+/**************************************************************************************************
+* hyper_sweep: Klass för sökning efter hyperparametrar via k-faldig korsvalidering.
+*              Träningsdatan läses in en gång och delas därefter av samtliga modeller, som
+*              enbart läser datan. Träningsuppsättningarna randomiseras en gång och delas in i
+*              k lika stora veck, där varje veck utgör valideringsdata för en modell som tränas
+*              på övriga veck. Vecken representeras enbart via index på samma sätt som
+*              m_train_order i klassen lin_reg, vilket gör att ingen träningsdata kopieras.
+*
+*              Varje kombination av konfiguration och veck utgör en oberoende deluppgift, där
+*              samtliga deluppgifter exekveras via en trådpool. Lediga trådar hämtar nästa
+*              deluppgift så fort de blir klara, där de mest krävande deluppgifterna startas
+*              först, vilket ger jämn lastbalans trots olika antal epoker per konfiguration.
+*              Eftersom deluppgifterna inte delar något skrivbart tillstånd skalar
+*              sökningen i stort sett linjärt med antalet kärnor.
+*
+*              Samma veck samt frön används för samtliga konfigurationer, vilket gör att
+*              resultatet är deterministiskt och oberoende av antalet trådar. Konfigurationerna
+*              rangordnas efter genomsnittlig valideringsförlust.
+*
+*              Klassens kopieringskonstruktor samt tilldelningsoperator är raderade.
+**************************************************************************************************/
+class hyper_sweep
+{
+protected:
+   /* Medlemmar: */
+   lin_reg m_dataset;                        /* Innehåller den delade träningsdatan. */
+   std::vector<sweep_config> m_configs;      /* Konfigurationer som skall utvärderas. */
+   std::vector<sweep_result> m_results;      /* Rangordnade resultat från senaste sökningen. */
+   std::vector<std::size_t> m_permutation;   /* Randomiserad ordning, som delas in i veck. */
+   std::size_t m_num_folds = 5;              /* Antalet veck vid korsvalidering. */
+   std::size_t m_num_threads = 1;            /* Antalet trådar vid sökningen. */
+   std::uint64_t m_seed = shuffler::default_seed; /* Frö för indelning i veck samt träning. */
+   double m_tolerance = 0;                   /* Tolerans för tidigt avbrott (noll = avstängd). */
+   std::size_t m_patience = 5;               /* Antal epoker utan förbättring innan avbrott. */
+   bool m_standardize = false;               /* Indikerar standardisering av insignalerna. */
+
+public:
+   hyper_sweep(void) { }
+   ~hyper_sweep(void) { }
+   hyper_sweep(hyper_sweep&) = delete;
+   hyper_sweep& operator = (hyper_sweep&) = delete;
+
+   std::size_t num_sets(void) const { return m_dataset.num_sets(); }
+   std::size_t num_folds(void) const { return m_num_folds; }
+   std::size_t num_threads(void) const { return m_num_threads; }
+   const std::vector<sweep_config>& configs(void) const { return m_configs; }
+   const std::vector<sweep_result>& results(void) const { return m_results; }
+
+   load_stats load_training_data(const std::string& filepath);
+   load_stats load_binary_data(const std::string& filepath);
+   void set_training_data(const std::vector<double>& train_in,
+                          const std::vector<double>& train_out);
+   void add_config(const sweep_config& config);
+   void add_grid(const std::vector<double>& learning_rates,
+                 const std::vector<std::size_t>& epochs,
+                 const std::size_t batch_size = 1,
+                 const optimizer_mode optimizer = optimizer_mode::sgd);
+   void clear_configs(void);
+   void set_folds(const std::size_t num_folds);
+   void set_num_threads(const std::size_t num_threads);
+   void set_seed(const std::uint64_t seed);
+   void set_early_stopping(const double tolerance,
+                           const std::size_t patience = 5);
+   void set_standardization(const bool standardize);
+   const std::vector<sweep_result>& run(void);
+   void print_results(std::ostream& ostream = std::cout,
+                      const std::size_t max_rows = 0) const;
+};
+
+#endif /* HYPER_SWEEP_HPP_ */
@@ -0,0 +1,351 @@
+/**************************************************************************************************
+* instrumentation.hpp: Innehåller funktionalitet för mätning av tidsåtgång samt genomströmning
+*                      vid träning och prediktion via klassmallen basic_instrumentation.
+*
+*                      Mätningarna aktiveras genom att makrot LIN_REG_INSTRUMENTATION definieras
+*                      vid kompilering, exempelvis via flaggan -DLIN_REG_INSTRUMENTATION. Annars
+*                      används en tom specialisering, vars medlemsfunktioner saknar innehåll och
+*                      optimeras bort helt av kompilatorn.
+**************************************************************************************************/
+#ifndef INSTRUMENTATION_HPP_
+#define INSTRUMENTATION_HPP_
+
+/* Inkluderingsdirektiv: */
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+#ifdef LIN_REG_INSTRUMENTATION
+static constexpr bool instrumentation_enabled = true;
+#else
+static constexpr bool instrumentation_enabled = false;
+#endif
+
+/* Faser vars tidsåtgång mäts: */
+enum class training_phase
+{
+   parse,        /* Inläsning samt tolkning av träningsdata. */
+   shuffle,      /* Randomisering av ordningsföljden inför en epok eller en buffert. */
+   epoch,        /* En hel epok, inklusive randomisering samt validering. */
+   predict_batch /* Prediktion av en array med insignaler. */
+};
+
+/* Antalet faser: */
+static constexpr std::size_t num_training_phases = 4;
+
+/**************************************************************************************************
+* phase_stats: Statistik för en enskild fas, bestående av antalet mätningar samt sammanlagd tid.
+**************************************************************************************************/
+struct phase_stats
+{
+   std::uint64_t count = 0; /* Antalet mätningar. */
+   double seconds = 0;      /* Sammanlagd tid i sekunder. */
+};
+
+/**************************************************************************************************
+* training_stats: Ögonblicksbild av insamlad statistik för en regressionsmodell, där
+*                 genomströmningen beräknas utifrån räknarna samt tidsåtgången per fas.
+**************************************************************************************************/
+struct training_stats
+{
+   std::uint64_t rows_parsed = 0;        /* Antalet inlästa träningsuppsättningar. */
+   std::uint64_t rows_skipped = 0;       /* Antalet överhoppade rader vid inläsning. */
+   std::uint64_t parse_failures = 0;     /* Antalet tal som ej kunde typomvandlas. */
+   std::uint64_t rows_trained = 0;       /* Antalet träningsuppsättningar som tränats på. */
+   std::uint64_t rows_predicted = 0;     /* Antalet predikterade utsignaler via predict_batch. */
+   std::uint64_t epochs = 0;             /* Antalet genomförda epoker. */
+   double loss = 0;                      /* Träningsförlust för senaste epoken. */
+   double validation_loss = 0;           /* Valideringsförlust för senaste epoken. */
+   phase_stats phases[num_training_phases]; /* Statistik per fas. */
+
+   const phase_stats& phase(const training_phase phase) const
+   {
+      return phases[static_cast<std::size_t>(phase)];
+   }
+
+   double parse_rows_per_second(void) const { return per_second(rows_parsed, training_phase::parse); }
+   double train_rows_per_second(void) const { return per_second(rows_trained, training_phase::epoch); }
+   double predict_rows_per_second(void) const { return per_second(rows_predicted, training_phase::predict_batch); }
+
+private:
+   double per_second(const std::uint64_t count,
+                     const training_phase phase) const
+   {
+      const auto seconds = this->phase(phase).seconds;
+      return seconds > 0 ? count / seconds : 0;
+   }
+};
+
+/**************************************************************************************************
+* basic_instrumentation: Klassmall för insamling av statistik, där mätningarna är aktiverade ifall
+*                        Enabled är true. Räknarna utgörs av atomära heltal som uppdateras med
+*                        avslappnad minnesordning (relaxed), vilket gör att statistiken kan läsas
+*                        från en annan tråd under träningen och att flera trådar kan genomföra
+*                        prediktion samtidigt utan lås. Räknarna uppdateras en gång per epok,
+*                        buffert eller anrop och aldrig per träningsuppsättning, så att
+*                        kostnaden i träningens innersta loop är noll.
+*
+*                        Efter varje epok anropas en valfri återanropsfunktion med aktuell
+*                        statistik, exempelvis för att skicka vidare mätvärdena till ett
+*                        övervakningssystem.
+**************************************************************************************************/
+template <bool Enabled>
+class basic_instrumentation
+{
+public:
+   using clock = std::chrono::steady_clock;
+   using time_point = clock::time_point;
+   using callback = std::function<void(const training_stats&)>;
+
+protected:
+   /* Medlemmar: */
+   std::atomic<std::uint64_t> m_rows_parsed{ 0 };    /* Antalet inlästa träningsuppsättningar. */
+   std::atomic<std::uint64_t> m_rows_skipped{ 0 };   /* Antalet överhoppade rader. */
+   std::atomic<std::uint64_t> m_parse_failures{ 0 }; /* Antalet tal som ej kunde typomvandlas. */
+   std::atomic<std::uint64_t> m_rows_trained{ 0 };   /* Antalet tränade träningsuppsättningar. */
+   std::atomic<std::uint64_t> m_rows_predicted{ 0 }; /* Antalet predikterade utsignaler. */
+   std::atomic<std::uint64_t> m_epochs{ 0 };         /* Antalet genomförda epoker. */
+   std::atomic<double> m_loss{ 0 };                  /* Träningsförlust för senaste epoken. */
+   std::atomic<double> m_validation_loss{ 0 };       /* Valideringsförlust för senaste epoken. */
+   std::atomic<std::uint64_t> m_counts[num_training_phases] = {};      /* Mätningar per fas. */
+   std::atomic<std::uint64_t> m_nanoseconds[num_training_phases] = {}; /* Tid per fas. */
+   time_point m_epoch_start;                         /* Tidpunkt för aktuell epoks början. */
+   callback m_callback;                              /* Anropas efter varje epok. */
+
+public:
+   basic_instrumentation(void) { }
+   ~basic_instrumentation(void) { }
+
+   /**********************************************************************************************
+   * take: Tar över räknarna samt återanropsfunktionen från other, vars räknare därefter
+   *       nollställs, vilket används när en regressionsmodell förflyttas.
+   *
+   *       - other: Objektet vars statistik skall tas över.
+   **********************************************************************************************/
+   void take(basic_instrumentation& other) noexcept
+   {
+      m_rows_parsed.store(other.m_rows_parsed.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      m_rows_skipped.store(other.m_rows_skipped.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      m_parse_failures.store(other.m_parse_failures.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      m_rows_trained.store(other.m_rows_trained.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      m_rows_predicted.store(other.m_rows_predicted.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      m_epochs.store(other.m_epochs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      m_loss.store(other.m_loss.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      m_validation_loss.store(other.m_validation_loss.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+      for (std::size_t i = 0; i < num_training_phases; ++i)
+      {
+         m_counts[i].store(other.m_counts[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+         m_nanoseconds[i].store(other.m_nanoseconds[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+      }
+
+      m_epoch_start = other.m_epoch_start;
+      m_callback = std::move(other.m_callback);
+      other.reset();
+      return;
+   }
+
+   /**********************************************************************************************
+   * now: Returnerar aktuell tidpunkt, som därefter passeras till add_time.
+   **********************************************************************************************/
+   time_point now(void) const { return clock::now(); }
+
+   /**********************************************************************************************
+   * add_time: Lägger till tiden som har förflutit sedan angiven tidpunkt till angiven fas.
+   *
+   *           - phase: Fasen som tiden avser.
+   *           - start: Tidpunkt för fasens början, erhållen via now.
+   **********************************************************************************************/
+   void add_time(const training_phase phase,
+                 const time_point start)
+   {
+      add_nanoseconds(phase, std::chrono::duration_cast<std::chrono::nanoseconds>(
+         clock::now() - start).count());
+      return;
+   }
+
+   /**********************************************************************************************
+   * add_time: Lägger till angivet antal sekunder till angiven fas.
+   *
+   *           - phase  : Fasen som tiden avser.
+   *           - seconds: Tid i sekunder.
+   **********************************************************************************************/
+   void add_time(const training_phase phase,
+                 const double seconds)
+   {
+      add_nanoseconds(phase, static_cast<std::int64_t>(seconds * 1e9));
+      return;
+   }
+
+   /**********************************************************************************************
+   * add_parsed: Lägger till statistik från inläsning av träningsdata.
+   *
+   *           - num_rows    : Antalet inlästa träningsuppsättningar.
+   *           - num_skipped : Antalet överhoppade rader.
+   *           - num_failures: Antalet tal som ej kunde typomvandlas.
+   **********************************************************************************************/
+   void add_parsed(const std::size_t num_rows,
+                   const std::size_t num_skipped,
+                   const std::size_t num_failures)
+   {
+      m_rows_parsed.fetch_add(num_rows, std::memory_order_relaxed);
+      m_rows_skipped.fetch_add(num_skipped, std::memory_order_relaxed);
+      m_parse_failures.fetch_add(num_failures, std::memory_order_relaxed);
+      return;
+   }
+
+   /**********************************************************************************************
+   * add_predicted: Lägger till angivet antal predikterade utsignaler samt tiden som har
+   *                förflutit sedan angiven tidpunkt till fasen predict_batch.
+   *
+   *                - num_values: Antalet predikterade utsignaler.
+   *                - start     : Tidpunkt för prediktionens början, erhållen via now.
+   **********************************************************************************************/
+   void add_predicted(const std::size_t num_values,
+                      const time_point start)
+   {
+      m_rows_predicted.fetch_add(num_values, std::memory_order_relaxed);
+      add_time(training_phase::predict_batch, start);
+      return;
+   }
+
+   /**********************************************************************************************
+   * begin_epoch: Lagrar tidpunkten för en ny epoks början.
+   **********************************************************************************************/
+   void begin_epoch(void)
+   {
+      m_epoch_start = clock::now();
+      return;
+   }
+
+   /**********************************************************************************************
+   * end_epoch: Registrerar en avslutad epok med angivet antal tränade träningsuppsättningar
+   *            samt angivna förluster och anropar därefter återanropsfunktionen, ifall en sådan
+   *            har angivits.
+   *
+   *            - num_rows       : Antalet träningsuppsättningar som tränades under epoken.
+   *            - loss           : Epokens träningsförlust.
+   *            - validation_loss: Epokens valideringsförlust (noll ifall validering saknas).
+   **********************************************************************************************/
+   void end_epoch(const std::size_t num_rows,
+                  const double loss,
+                  const double validation_loss)
+   {
+      add_time(training_phase::epoch, m_epoch_start);
+      m_rows_trained.fetch_add(num_rows, std::memory_order_relaxed);
+      m_epochs.fetch_add(1, std::memory_order_relaxed);
+      m_loss.store(loss, std::memory_order_relaxed);
+      m_validation_loss.store(validation_loss, std::memory_order_relaxed);
+      if (m_callback) m_callback(stats());
+      return;
+   }
+
+   /**********************************************************************************************
+   * set_callback: Sätter återanropsfunktion som anropas med aktuell statistik efter varje
+   *               epok. En tom funktion tar bort tidigare angiven återanropsfunktion.
+   *
+   *               - function: Återanropsfunktionen.
+   **********************************************************************************************/
+   void set_callback(callback function)
+   {
+      m_callback = std::move(function);
+      return;
+   }
+
+   /**********************************************************************************************
+   * stats: Returnerar en ögonblicksbild av insamlad statistik. Räknarna läses var för sig,
+   *        vilket gör att ögonblicksbilden kan sakna en pågående uppdatering.
+   **********************************************************************************************/
+   training_stats stats(void) const
+   {
+      training_stats stats;
+      stats.rows_parsed = m_rows_parsed.load(std::memory_order_relaxed);
+      stats.rows_skipped = m_rows_skipped.load(std::memory_order_relaxed);
+      stats.parse_failures = m_parse_failures.load(std::memory_order_relaxed);
+      stats.rows_trained = m_rows_trained.load(std::memory_order_relaxed);
+      stats.rows_predicted = m_rows_predicted.load(std::memory_order_relaxed);
+      stats.epochs = m_epochs.load(std::memory_order_relaxed);
+      stats.loss = m_loss.load(std::memory_order_relaxed);
+      stats.validation_loss = m_validation_loss.load(std::memory_order_relaxed);
+
+      for (std::size_t i = 0; i < num_training_phases; ++i)
+      {
+         stats.phases[i].count = m_counts[i].load(std::memory_order_relaxed);
+         stats.phases[i].seconds = m_nanoseconds[i].load(std::memory_order_relaxed) * 1e-9;
+      }
+      return stats;
+   }
+
+   /**********************************************************************************************
+   * reset: Nollställer samtliga räknare. Återanropsfunktionen behålls.
+   **********************************************************************************************/
+   void reset(void)
+   {
+      m_rows_parsed.store(0, std::memory_order_relaxed);
+      m_rows_skipped.store(0, std::memory_order_relaxed);
+      m_parse_failures.store(0, std::memory_order_relaxed);
+      m_rows_trained.store(0, std::memory_order_relaxed);
+      m_rows_predicted.store(0, std::memory_order_relaxed);
+      m_epochs.store(0, std::memory_order_relaxed);
+      m_loss.store(0, std::memory_order_relaxed);
+      m_validation_loss.store(0, std::memory_order_relaxed);
+
+      for (std::size_t i = 0; i < num_training_phases; ++i)
+      {
+         m_counts[i].store(0, std::memory_order_relaxed);
+         m_nanoseconds[i].store(0, std::memory_order_relaxed);
+      }
+      return;
+   }
+
+protected:
+   /**********************************************************************************************
+   * add_nanoseconds: Lägger till en mätning om angivet antal nanosekunder till angiven fas.
+   *
+   *                  - phase      : Fasen som tiden avser.
+   *                  - nanoseconds: Tid i nanosekunder.
+   **********************************************************************************************/
+   void add_nanoseconds(const training_phase phase,
+                        const std::int64_t nanoseconds)
+   {
+      const auto i = static_cast<std::size_t>(phase);
+      m_counts[i].fetch_add(1, std::memory_order_relaxed);
+      m_nanoseconds[i].fetch_add(nanoseconds > 0 ? static_cast<std::uint64_t>(nanoseconds) : 0,
+                                 std::memory_order_relaxed);
+      return;
+   }
+};
+
+/**************************************************************************************************
+* basic_instrumentation<false>: Specialisering utan mätningar, vilket används när makrot
+*                               LIN_REG_INSTRUMENTATION inte har definierats. Klassen saknar
+*                               medlemmar och samtliga medlemsfunktioner saknar innehåll,
+*                               vilket gör att anropen optimeras bort helt.
+**************************************************************************************************/
+template <>
+class basic_instrumentation<false>
+{
+public:
+   struct time_point { };
+   using callback = std::function<void(const training_stats&)>;
+
+   void take(basic_instrumentation&) noexcept { }
+   time_point now(void) const { return time_point(); }
+   void add_time(const training_phase, const time_point) { }
+   void add_time(const training_phase, const double) { }
+   void add_parsed(const std::size_t, const std::size_t, const std::size_t) { }
+   void add_predicted(const std::size_t, const time_point) { }
+   void begin_epoch(void) { }
+   void end_epoch(const std::size_t, const double, const double) { }
+   void set_callback(callback) { }
+   training_stats stats(void) const { return training_stats(); }
+   void reset(void) { }
+};
+
+/* Statistik enligt makrot LIN_REG_INSTRUMENTATION: */
+using instrumentation = basic_instrumentation<instrumentation_enabled>;
+
+#endif /* INSTRUMENTATION_HPP_ */
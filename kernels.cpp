@@ -0,0 +1,275 @@
+/**************************************************************************************************
+* kernels.cpp: Innehåller vektoriserade beräkningskärnor för träning av regressionsmodeller. 
+*              Vilken instruktionsuppsättning som används avgörs vid kompilering.
+**************************************************************************************************/
+#include "kernels.hpp"
+
+#include <cstdint>
+
+#if defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__))
+#include <immintrin.h>
+#endif
+
+/* Statiska konstanter: */
+static constexpr std::size_t streaming_threshold = 1 << 20; /* Antal element för att skriva förbi cache. */
+
+/**************************************************************************************************
+* batch_gradient: Beräknar summan av felen samt summan av felen multiplicerat med respektive 
+*                 insignal för angivna träningsuppsättningar, vilket utgör gradienterna för 
+*                 bias respektive vikt vid minstakvadratfel. Felet för varje träningsuppsättning 
+*                 beräknas som skillnaden mellan referensvärdet och predikterat värde. Summan av 
+*                 de kvadrerade felen beräknas i samma genomgång, vilket gör att förlusten kan 
+*                 följas under träningen utan extra läsningar av träningsdatan.
+*
+*                 Beräkningen sker över sammanhängande arrayer utan beroenden mellan 
+*                 iterationerna, vilket medför att flera träningsuppsättningar kan behandlas 
+*                 parallellt via SIMD-instruktioner. Den skalära implementeringen använder 
+*                 fyra oberoende ackumulatorer, vilket möjliggör autovektorisering.
+*
+*                 - input            : Insignaler för träningsuppsättningarna.
+*                 - output           : Referensvärden för träningsuppsättningarna.
+*                 - num_sets         : Antalet träningsuppsättningar.
+*                 - weight           : Modellens aktuella vikt.
+*                 - bias             : Modellens aktuella vilovärde.
+*                 - sum_error        : Referens till variabel där summan av felen lagras.
+*                 - sum_error_input  : Referens till variabel där summan av felen multiplicerat
+*                                      med respektive insignal lagras.
+*                 - sum_squared_error: Referens till variabel där summan av de kvadrerade 
+*                                      felen lagras.
+**************************************************************************************************/
+void batch_gradient(const double* input,
+                    const double* output,
+                    const std::size_t num_sets,
+                    const double weight,
+                    const double bias,
+                    double& sum_error,
+                    double& sum_error_input,
+                    double& sum_squared_error)
+{
+   std::size_t i = 0;
+   double error_sum = 0;
+   double error_input_sum = 0;
+   double squared_error_sum = 0;
+
+#if defined(__AVX512F__)
+   const auto w = _mm512_set1_pd(weight);
+   const auto b = _mm512_set1_pd(bias);
+   auto acc_e = _mm512_setzero_pd();
+   auto acc_ex = _mm512_setzero_pd();
+   auto acc_ee = _mm512_setzero_pd();
+
+   for (; i + 8 <= num_sets; i += 8)
+   {
+      const auto x = _mm512_loadu_pd(input + i);
+      const auto y = _mm512_loadu_pd(output + i);
+      const auto e = _mm512_sub_pd(y, _mm512_fmadd_pd(w, x, b));
+      acc_e = _mm512_add_pd(acc_e, e);
+      acc_ex = _mm512_fmadd_pd(e, x, acc_ex);
+      acc_ee = _mm512_fmadd_pd(e, e, acc_ee);
+   }
+
+   double lanes_e[8], lanes_ex[8], lanes_ee[8];
+   _mm512_storeu_pd(lanes_e, acc_e);
+   _mm512_storeu_pd(lanes_ex, acc_ex);
+   _mm512_storeu_pd(lanes_ee, acc_ee);
+
+   for (std::size_t j = 0; j < 8; ++j)
+   {
+      error_sum += lanes_e[j];
+      error_input_sum += lanes_ex[j];
+      squared_error_sum += lanes_ee[j];
+   }
+#elif defined(__AVX2__) && defined(__FMA__)
+   const auto w = _mm256_set1_pd(weight);
+   const auto b = _mm256_set1_pd(bias);
+   auto acc_e = _mm256_setzero_pd();
+   auto acc_ex = _mm256_setzero_pd();
+   auto acc_ee = _mm256_setzero_pd();
+
+   for (; i + 4 <= num_sets; i += 4)
+   {
+      const auto x = _mm256_loadu_pd(input + i);
+      const auto y = _mm256_loadu_pd(output + i);
+      const auto e = _mm256_sub_pd(y, _mm256_fmadd_pd(w, x, b));
+      acc_e = _mm256_add_pd(acc_e, e);
+      acc_ex = _mm256_fmadd_pd(e, x, acc_ex);
+      acc_ee = _mm256_fmadd_pd(e, e, acc_ee);
+   }
+
+   double lanes_e[4], lanes_ex[4], lanes_ee[4];
+   _mm256_storeu_pd(lanes_e, acc_e);
+   _mm256_storeu_pd(lanes_ex, acc_ex);
+   _mm256_storeu_pd(lanes_ee, acc_ee);
+   error_sum = (lanes_e[0] + lanes_e[1]) + (lanes_e[2] + lanes_e[3]);
+   error_input_sum = (lanes_ex[0] + lanes_ex[1]) + (lanes_ex[2] + lanes_ex[3]);
+   squared_error_sum = (lanes_ee[0] + lanes_ee[1]) + (lanes_ee[2] + lanes_ee[3]);
+#else
+   double acc_e[4] = { 0, 0, 0, 0 };
+   double acc_ex[4] = { 0, 0, 0, 0 };
+   double acc_ee[4] = { 0, 0, 0, 0 };
+
+   for (; i + 4 <= num_sets; i += 4)
+   {
+      for (std::size_t j = 0; j < 4; ++j)
+      {
+         const auto e = output[i + j] - (weight * input[i + j] + bias);
+         acc_e[j] += e;
+         acc_ex[j] += e * input[i + j];
+         acc_ee[j] += e * e;
+      }
+   }
+
+   error_sum = (acc_e[0] + acc_e[1]) + (acc_e[2] + acc_e[3]);
+   error_input_sum = (acc_ex[0] + acc_ex[1]) + (acc_ex[2] + acc_ex[3]);
+   squared_error_sum = (acc_ee[0] + acc_ee[1]) + (acc_ee[2] + acc_ee[3]);
+#endif
+
+   for (; i < num_sets; ++i)
+   {
+      const auto e = output[i] - (weight * input[i] + bias);
+      error_sum += e;
+      error_input_sum += e * input[i];
+      squared_error_sum += e * e;
+   }
+
+   sum_error = error_sum;
+   sum_error_input = error_input_sum;
+   sum_squared_error = squared_error_sum;
+   return;
+}
+
+/**************************************************************************************************
+* dot_product: Returnerar skalärprodukten av två arrayer med angivet antal element, exempelvis 
+*              insignalerna för en träningsuppsättning och modellens vikter. Beräkningen sker 
+*              via SIMD-instruktioner ifall sådana finns tillgängliga, annars via fyra 
+*              oberoende ackumulatorer som möjliggör autovektorisering.
+*
+*              - a           : Den första arrayen.
+*              - b           : Den andra arrayen.
+*              - num_elements: Antalet element i respektive array.
+**************************************************************************************************/
+double dot_product(const double* a,
+                   const double* b,
+                   const std::size_t num_elements)
+{
+   std::size_t i = 0;
+   double sum = 0;
+
+#if defined(__AVX512F__)
+   auto acc = _mm512_setzero_pd();
+
+   for (; i + 8 <= num_elements; i += 8)
+   {
+      acc = _mm512_fmadd_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i), acc);
+   }
+
+   double lanes[8];
+   _mm512_storeu_pd(lanes, acc);
+
+   for (std::size_t j = 0; j < 8; ++j)
+   {
+      sum += lanes[j];
+   }
+#elif defined(__AVX2__) && defined(__FMA__)
+   auto acc = _mm256_setzero_pd();
+
+   for (; i + 4 <= num_elements; i += 4)
+   {
+      acc = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), acc);
+   }
+
+   double lanes[4];
+   _mm256_storeu_pd(lanes, acc);
+   sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#else
+   double acc[4] = { 0, 0, 0, 0 };
+
+   for (; i + 4 <= num_elements; i += 4)
+   {
+      for (std::size_t j = 0; j < 4; ++j)
+      {
+         acc[j] += a[i + j] * b[i + j];
+      }
+   }
+
+   sum = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+#endif
+
+   for (; i < num_elements; ++i)
+   {
+      sum += a[i] * b[i];
+   }
+   return sum;
+}
+
+/**************************************************************************************************
+* predict_linear: Beräknar output[i] = weight * input[i] + bias för angivet antal element. 
+*                 Iterationerna saknar beroenden sinsemellan och behandlas via SIMD-instruktioner 
+*                 ifall sådana finns tillgängliga. Vid mycket stora arrayer, som inte ryms i 
+*                 cacheminnet, skrivs resultatet via icke-temporala skrivningar (streaming 
+*                 stores), vilket undviker att utdatan först läses in i cacheminnet och därmed 
+*                 minskar minnestrafiken med en tredjedel.
+*
+*                 - input     : Array innehållande insignaler.
+*                 - output    : Array där predikterade utsignaler skall lagras.
+*                 - num_values: Antalet element.
+*                 - weight    : Modellens vikt.
+*                 - bias      : Modellens vilovärde.
+**************************************************************************************************/
+void predict_linear(const double* input,
+                    double* output,
+                    const std::size_t num_values,
+                    const double weight,
+                    const double bias)
+{
+   std::size_t i = 0;
+
+#if defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__))
+   if (num_values >= streaming_threshold)
+   {
+      for (; i < num_values && reinterpret_cast<std::uintptr_t>(output + i) % 64 != 0; ++i)
+      {
+         output[i] = weight * input[i] + bias;
+      }
+#if defined(__AVX512F__)
+      const auto w = _mm512_set1_pd(weight);
+      const auto b = _mm512_set1_pd(bias);
+
+      for (; i + 8 <= num_values; i += 8)
+      {
+         _mm512_stream_pd(output + i, _mm512_fmadd_pd(w, _mm512_loadu_pd(input + i), b));
+      }
+#else
+      const auto w = _mm256_set1_pd(weight);
+      const auto b = _mm256_set1_pd(bias);
+
+      for (; i + 4 <= num_values; i += 4)
+      {
+         _mm256_stream_pd(output + i, _mm256_fmadd_pd(w, _mm256_loadu_pd(input + i), b));
+      }
+#endif
+      _mm_sfence();
+   }
+#endif
+
+   for (; i < num_values; ++i)
+   {
+      output[i] = weight * input[i] + bias;
+   }
+   return;
+}
+
+/**************************************************************************************************
+* kernel_isa: Returnerar namnet på den instruktionsuppsättning som beräkningskärnorna har 
+*             kompilerats för, vilket underlättar jämförelser av prestanda.
+**************************************************************************************************/
+const char* kernel_isa(void)
+{
+#if defined(__AVX512F__)
+   return "avx512";
+#elif defined(__AVX2__) && defined(__FMA__)
+   return "avx2";
+#else
+   return "scalar";
+#endif
+}
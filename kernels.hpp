@@ -0,0 +1,32 @@
+/**************************************************************************************************
+* kernels.hpp: Innehåller vektoriserade beräkningskärnor för träning av regressionsmodeller, 
+*              vilka opererar på sammanhängande arrayer av träningsdata. AVX-512 eller AVX2 
+*              används ifall koden kompileras med stöd för detta (exempelvis via flaggan 
+*              -march=native), annars används en skalär implementering.
+**************************************************************************************************/
+#ifndef KERNELS_HPP_
+#define KERNELS_HPP_
+
+/* Inkluderingsdirektiv: */
+#include <cstddef>
+
+/* Funktionsdeklarationer: */
+void batch_gradient(const double* input,
+                    const double* output,
+                    const std::size_t num_sets,
+                    const double weight,
+                    const double bias,
+                    double& sum_error,
+                    double& sum_error_input,
+                    double& sum_squared_error);
+double dot_product(const double* a,
+                   const double* b,
+                   const std::size_t num_elements);
+void predict_linear(const double* input,
+                    double* output,
+                    const std::size_t num_values,
+                    const double weight,
+                    const double bias);
+const char* kernel_isa(void);
+
+#endif /* KERNELS_HPP_ */
@@ -1,405 +1,1840 @@
-/**************************************************************************************************
-* lin_reg.cpp: Innehller medlemsfunktioner tillhrande klassen lin_reg, vilket anvnds fr 
-*              implementering av maskininlrningsmodeller som baseras p linjr regression.
-**************************************************************************************************/
-#include "lin_reg.hpp"
-
-/* Statiska funktioner: */
-static bool char_is_digit(const char c);
-static void retrieve_double(std::vector<double>& data, 
-                            std::string& s);
-
-/**************************************************************************************************
-* extract: Extraherar trningsdata i form av flyttal ur angiven strng och lagrar som trningsdata 
-*          fr angiven regressionsmodell. Ifall tv flyttal lyckas extraheras lagras dessa som en 
-*          trningsuppsttning via vektorer m_train_in samt m_train_out. Index fr varje lagrad
-*          trningsuppsttning lagras ocks via vektorn m_train_order fr att enkelt kunna 
-*          randomisera ordningsfljden fr trningsuppsttningarna vid trning utan att frflytta 
-*          trningsdatan, vilket genomfrs fr att minska risken att eventuella icke avsedda 
-*          mnster som frekommer i trningsdatan skall pverka trningen av regressionsmodellen.
-* 
-*          - s: Strng innehllande de flyttal som skall extraheras.
-**************************************************************************************************/
-void lin_reg::extract(const std::string& s)
-{
-   std::string num_str;
-   std::vector<double> data;
-
-   for (auto& i : s)
-   {
-      if (char_is_digit(i))
-      {
-         num_str += i;
-      }
-      else
-      {
-         retrieve_double(data, num_str);
-      }
-   }
-
-   retrieve_double(data, num_str);
-
-   if (data.size() == 2)
-   {
-      m_train_in.push_back(data[0]);
-      m_train_out.push_back(data[1]);
-      m_train_order.push_back(m_train_order.size());
-   }
-   return;
-}
-
-/**************************************************************************************************
-* shuffle: Randomiserar den inbrdes ordningsfljden fr angiven regressionsmodells 
-*          trningsuppsttningar genom att frflytta innehllet i vektorn m_train_order, som
-*          lagrar index fr respektive trningsuppsttning.
-**************************************************************************************************/
-void lin_reg::shuffle(void)
-{
-   for (std::size_t i = 0; i < m_train_order.size(); ++i)
-   {
-      const auto r = rand() % m_train_order.size();
-      const auto temp = m_train_order[i];
-      m_train_order[i] = m_train_order[r];
-      m_train_order[r] = temp;
-   }
-   return;
-}
-
-/**************************************************************************************************
-* optimize: Justerar parametrar fr angiven regressionsmodell i syfte att minska aktuellt fel. 
-*           Prediktion genomfrs via given insignal, dr predikterat vrde jmfrs mot givet 
-*           referensvrde fr att berkna aktuellt fel. Modellens parametrar justeras sedan med en 
-*           brkdel av felet, vilket avgrs av lrhastigheten. 
-*
-*           Fr vikten (k-vrdet) tas aktuell insignal i tanke gllande graden av justering, 
-*           d viktens betydelse fr aktuell fel str i direkt proportion med aktuell insignal 
-*           (ju hgre insignal, desto mer pverkan har vikten p predikterad utsignal och drmed 
-*           eventuellt fel).
-* 
-*           - input    : Insignal frn trningsdata som anvnds fr att genomfra prediktion.
-*           - reference: Referensvrde frn trningsdatan, som anvnds fr att berkna aktuellt
-*                        fel via jmfrelse med predikterat vrde.
-**************************************************************************************************/
-void lin_reg::optimize(const double input, 
-                       const double reference)
-{
-   const auto prediction = m_weight * input + m_bias;
-   const auto error = reference - prediction;
-   const auto change_rate = error * m_learning_rate;
-   m_bias += change_rate;
-   m_weight += change_rate * input;
-   return;
-}
-
-/**************************************************************************************************
-* lin_reg: Konstruktor fr klassen lin_reg, vilket anvnds fr att initiera
-*                    en ny regressionsmodell som baseras p linjr regression. Angivet antal 
-*                    epoker samt lrhastighet lagras infr trning. Trningsdata mste dock 
-*                    tillfras i efterhand via ngon av medlemsfunktioner load_training_data
-*                    (fr att lsa in trningsuppsttingarna frn en fil) eller set_training_data
-*                    (fr att passera trningsdata via referenser till vektorer).
-* 
-*                    - num_epochs   : Antalet epoker/omgngar som skall genomfras vid trning.
-*                    - learning_rate: Lrhastighet, avgr med hur stor andel av aktuellt fel som
-*                                     modellens parametrar (bias och vikt) skall justeras.
-**************************************************************************************************/
-lin_reg::lin_reg(const std::size_t num_epochs, 
-                 const double learning_rate)
-{
-   set_epochs(num_epochs);
-   set_learning_rate(learning_rate);
-   return;
-}
-
-/**************************************************************************************************
-* lin_reg: Frflyttningskonstruktor, som medfr frflyttning av minne frn en 
-*                    regressionsmodell till en annan, i detta fall frn source till angivet 
-*                    objekt this via anrop av funktionen std::move.
-* 
-*                    Innehllet lagrat av regressionsmodellen source kopieras till angiven modell 
-*                    this, fljt av att source nollstlls. Efter frflyttningen har drmed enbart 
-*                    angiven modell this tillgng till minnet i frga.
-* 
-*                    - source: Den regressionsmodell som minnet skall frflyttas frn.
-**************************************************************************************************/
-lin_reg::lin_reg(lin_reg&& source) noexcept
-{
-   this->m_train_in = source.m_train_in;
-   this->m_train_out = source.m_train_out;
-   this->m_train_order = source.m_train_order;
-   this->m_weight = source.m_weight;
-   this->m_bias = source.m_bias;
-   this->m_learning_rate = source.m_learning_rate;
-   this->m_num_epochs = source.m_num_epochs;  
-
-   source.m_train_in.clear();
-   source.m_train_out.clear();
-   source.m_train_order.clear();
-   source.m_weight = 0;
-   source.m_bias = 0;
-   source.m_learning_rate = 0;
-   source.m_num_epochs = 0;
-   return;
-}
-
-/**************************************************************************************************
-* set_epochs: Uppdaterar antalet epoker som sker vid trning fr angiven regressionsmodell ifall 
-*             angivet nytt antal verstiger noll.
-*
-*             - num_epochs: Det nya antalet epoker som skall genomfras vid trning.
-**************************************************************************************************/
-void lin_reg::set_epochs(const std::size_t num_epochs)
-{
-   if (num_epochs > 0)
-   {
-      m_num_epochs = num_epochs;
-   }
-   return;
-}
-
-/**************************************************************************************************
-* set_learning_rate: Stter ny lrhastighet fr att justera parametrarna fr angiven 
-*                    regressionsmodell ifall angivet nytt vrde verstiger noll.
-* 
-*                    - learning_rate: Den nya lrhastighet som skall anvndas fr att justera
-*                                     modellens parametrar (bias och vikt) vid fel.
-**************************************************************************************************/
-void lin_reg::set_learning_rate(const double learning_rate)
-{
-   if (learning_rate > 0)
-   {
-      m_learning_rate = learning_rate;
-   }
-   return;
-}
-
-/**************************************************************************************************
-* load_training_data: Lser in trningsdata frn en fil via angiven filskvg, extraherar denna
-*                     data i form av flyttal och lagrar som trningsuppsttningar fr angiven
-*                     regressionsmodell.
-*                    
-*                     - filepath: Filskvgen som trningsdatan skall lsas frn.
-**************************************************************************************************/
-void lin_reg::load_training_data(const std::string& filepath)
-{
-   std::ifstream fstream(filepath, std::ios::in);
-
-   if (!fstream)
-   {
-      std::cerr << "Could not open file at path " << filepath << "!\n\n";
-   }
-   else
-   {
-      std::string s;
-      while (std::getline(fstream, s))
-      {
-         extract(s);
-      }
-   }
-   return;
-}
-
-/**************************************************************************************************
-* set_training_data: Kopierar trningsdata till angiven regressionsmodell frn refererade vektorer 
-*                    samt lagrar index fr respektive trningsuppsttning. Enbart fullstndiga 
-*                    trningsuppsttningar dr bde in- och utsignal frekommer lagras.
-* 
-*                    - train_in : Innehller insignaler fr samtliga trningsuppsttningar.
-*                    - train_out: Innehller utsignaler fr samtliga trningsuppsttningar.
-**************************************************************************************************/
-void lin_reg::set_training_data(const std::vector<double>& train_in,
-                                const std::vector<double>& train_out)
-{
-   auto num_sets = train_in.size();
-
-   if (train_in.size() > train_out.size())
-   {
-      num_sets = train_out.size();
-   }
-
-   m_train_in.resize(num_sets);
-   m_train_out.resize(num_sets);
-   m_train_order.resize(num_sets);
-
-   for (std::size_t i = 0; i < num_sets; ++i)
-   {
-      m_train_in[i] = train_in[i];
-      m_train_out[i] = train_out[i];
-      m_train_order[i] = i;
-   }
-   return;
-}
-
-/**************************************************************************************************
-* train: Trnar angiven regressionsmodell under angivet antal epoker. Infr varje ny epok 
-*        randomiseras ordningsfljden p trningsuppsttningarna fr att undvika att eventuella 
-*        mnster som upptrder i trningsdatan skall pverka trningen av modellen. 
-*
-*        Varje varv optimeras modellens parametrar genom att en prediktion genomfrs via en 
-*        insignal frn trningsdatan, dr det predikterade vrdet jmfrs med referensvrdet 
-*        frn trningsdatan. Differensen mellan dessa vrden utgr aktuellt fel och parametrarna
-*        justeras med en brkdel av detta vrde, beroende p aktuell lrhastighet.
-**************************************************************************************************/
-void lin_reg::train(void)
-{
-   for (std::size_t i = 0; i < m_num_epochs; ++i)
-   {
-      shuffle();
-
-      for (auto& j : m_train_order)
-      {
-         optimize(m_train_in[j], m_train_out[j]);
-      }
-   }
-   return;
-}
-
-/**************************************************************************************************
-* predict: Genomfr prediktion med angiven regressionsmodell via angiven insignal och returnerar 
-*          motsvarande predikterad utsignal i form av ett flytta.
-* 
-*          - input: Den insignal som prediktion skall genomfras p.
-**************************************************************************************************/
-double lin_reg::predict(const double input)
-{
-   return m_weight * input + m_bias;
-}
-
-/**************************************************************************************************
-* predict_all: Genomfr prediktion med angiven regressionsmodell fr samtliga insignaler som
-*              frekommer i trningsdatan och skriver ut motsvarande predikterade utsignaler via 
-*              angiven utstrm, dr standardutenhet std::cout anvnds som default fr utskrift i
-*              i terminalen. Vrden mycket nra noll [-threshold, threshold] avrundas till noll
-*              fr att undvika utskrift med ett flertal decimaler i ondan, vilket annars sker 
-*              just runt noll.
-* 
-*              - threshold: Trskelvrde runt nollpunkten [-threshold, threshold], dr
-*                           predikterad vrde skall avrundas till noll (default = 0.001).
-*              - ostream  : Angiven utstrm (default = std::cout).
-**************************************************************************************************/
-void lin_reg::predict_all(const double threshold, 
-                          std::ostream& ostream)
-{
-   const auto* last = &m_train_in[m_train_in.size() - 1];
-   ostream << "----------------------------------------------------------------------------\n";
-
-   for (auto& i : m_train_in)
-   {
-      const auto prediction = predict(i);
-      ostream << "Input: " << i << "\n";
-
-      if (prediction > -threshold && prediction < threshold)
-      {
-         ostream << "Output: " << 0 << "\n";
-      }
-      else
-      {
-         ostream << "Output: " << predict(i) << "\n";
-      }
-
-      if (&i < last) ostream << "\n";
-   }
-
-   ostream << "----------------------------------------------------------------------------\n\n";
-   return;
-}
-
-/**************************************************************************************************
-* predict_range: Genomfr prediktion med angiven regressionsmodell fr insignaler inom intervallet 
-*                mellan angivet start- och slutvrde [start_val, end_val], dr inkrementering av 
-*                insignalen sker inom detta intervall med angivet stegvrde step.
-* 
-*                Varje insignal samt motsvarande predikterat vrde skrivs ut via angiven utstrm,
-*                dr standardutenheten std::cout anvnds som default fr utskrift i terminalen. 
-*                Vrden mycket nra noll [-threshold, threshold] avrundas till noll fr att 
-*                undvika utskrift med ett flertal decimaler i ondan, vilket annars sker just 
-*                runt noll.
-* 
-*                - start_val: Minvrde fr det intervall av insignaler som skall testas.
-*                - end_val  : Maxvrde fr det intervall av insignaler som skall testas.
-*                - step     : Stegvrde/inkrementeringsvrde fr insignaler (default = 1.0).
-*                - threshold: Trskelvrde, dr samtliga predikterade vrden som ligger inom
-*                             intervallet [-threshold, threshold] avrundas till noll fr att 
-*                             undvika utskrift med ondigt antal decimaler (default = 0.001).
-*                - ostream:   Angiven utstrm (default = std::cout).
-**************************************************************************************************/
-void lin_reg::predict_range(const double start_val, 
-                            const double end_val,
-                            const double step, 
-                            const double threshold, 
-                            std::ostream& ostream)
-{
-   ostream << "----------------------------------------------------------------------------\n";
-
-   for (double i = start_val; i <= end_val; i += step)
-   {
-      const auto prediction = predict(i);
-      ostream << "Input: " << i << "\n";
-
-      if (prediction > -threshold && prediction < threshold)
-      {
-         ostream << "Output: " << 0 << "\n";
-      }
-      else
-      {
-         ostream << "Output: " << predict(i) << "\n";
-      } 
-
-      if (i < end_val) ostream << "\n";
-   }
-
-   ostream << "----------------------------------------------------------------------------\n\n";
-   return;
-}
-
-/**************************************************************************************************
-* char_is_digit: Indikerar ifall givet tecken utgr en siffra eller ett relaterat tecken, ssom
-*                ett minustecken eller en punkt. Eftersom flyttal ibland matas in bde med
-*                punkt samt kommatecken s utgr bda giltiga tecken.
-* 
-*                - c: Det tecken som skall kontrolleras.
-**************************************************************************************************/
-static bool char_is_digit(const char c)
-{
-   const auto s = "0123456789-.,";
-   for (auto i = s; *i; ++i)
-   {
-      if (c == *i)
-      {
-         return true;
-      }
-   }
-   return false;
-}
-
-/**************************************************************************************************
-* retrieve_double: Typomvandlar innehll lagrat som text till ett flyttal och lagrar detta i
-*                  angiven vektor. Innan typomvandlingen ger rum erstts eventuella kommatecken 
-*                  med punkt, vilket mjliggr att flyttal kan lsas in bde med punkt eller
-*                  kommatecken som decimaltecken.
-* 
-*                  - data: Den vektor som typomvandlat flyttal skall lagras i.
-*                  - s   : Data i form av text som skall typomvandlas till ett flyttal.
-**************************************************************************************************/
-static void retrieve_double(std::vector<double>& data, 
-                            std::string& s)
-{
-   for (auto& i : s)
-   {
-      if (i == ',') i = '.';
-   }
-
-   try
-   {
-      const auto number = std::stod(s);
-      data.push_back(number);
-   }
-   catch (std::invalid_argument&)
-   {
-      std::cerr << "Failed to convert " << s << " to double\n";
-   }
-
-   s.clear();
-   return;
-}
-
+/**************************************************************************************************
+* lin_reg.cpp: Innehåller medlemsfunktioner tillhörande klassen lin_reg, vilket används för 
+*              implementering av maskininlärningsmodeller som baseras på linjär regression.
+**************************************************************************************************/
+#include "lin_reg.hpp"
+#include "mapped_file.hpp"
+#include "text_parser.hpp"
+#include "kernels.hpp"
+#include "spsc_queue.hpp"
+#include "prediction_writer.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <utility>
+
+/* Statiska konstanter: */
+static constexpr std::size_t shard_cost_ratio = 4;        /* Beräkningstid per del i förhållande till synkronisering. */
+static constexpr std::size_t shard_granularity = 1024;    /* Minsta antal träningsuppsättningar per tråd. */
+static constexpr double min_parallel_speedup = 1.25;       /* Minsta uppmätta uppsnabbning för uppdelning. */
+static constexpr std::size_t calibration_rows = 16384;    /* Antal träningsuppsättningar per tråd vid kalibrering. */
+static constexpr std::size_t calibration_rounds = 16;     /* Antal omgångar vid kalibrering. */
+static constexpr std::size_t stream_block_size = 1 << 20; /* Antal byte per läsning vid strömning. */
+static constexpr std::size_t pipeline_block_size = 4 << 20; /* Antal byte per block vid pipelinad träning. */
+static constexpr std::size_t pipeline_num_chunks = 4;      /* Antal buffertar per tolkningstråd. */
+static constexpr std::size_t export_block_size = 1024;    /* Antal prediktioner per block vid utskrift. */
+
+/**************************************************************************************************
+* pipeline_chunk: Buffert för tolkade träningsuppsättningar, som överförs från en tolkningstråd 
+*                 till tränande tråd vid pipelinad träning och därefter återlämnas för 
+*                 återanvändning. Flaggan block_end markerar den sista bufferten för ett block, 
+*                 medan flaggan stream_end markerar den sista bufferten från en tolkningstråd.
+**************************************************************************************************/
+struct pipeline_chunk
+{
+   std::vector<double> input;  /* Insignaler. */
+   std::vector<double> output; /* Utsignaler. */
+   std::size_t num_sets = 0;   /* Antalet lagrade träningsuppsättningar. */
+   bool block_end = false;     /* Indikerar att bufferten är den sista för aktuellt block. */
+   bool stream_end = false;    /* Indikerar att tolkningstråden har avslutat sitt arbete. */
+};
+
+/**************************************************************************************************
+* pipeline_threads: Håller tolkningstrådarna vid pipelinad träning och ser till att dessa alltid 
+*                   sammanfogas, även ifall ett undantag kastas i tränande tråd, eftersom 
+*                   destruktorn för std::thread annars anropar std::terminate. Vid sammanfogning 
+*                   sätts flaggan stop, varefter angiven funktion drain anropas med index för 
+*                   varje startad tolkningstråd, så att tråden kan slutföra pågående block och 
+*                   skicka sin slutmarkering innan den sammanfogas.
+**************************************************************************************************/
+template <typename Drain>
+class pipeline_threads
+{
+protected:
+   /* Medlemmar: */
+   std::vector<std::thread> m_threads; /* Startade tolkningstrådar. */
+   std::atomic<bool>& m_stop;          /* Flagga som signalerar tolkningstrådarna att avsluta. */
+   Drain& m_drain;                     /* Tömmer ringbuffertarna för en tolkningstråd. */
+
+public:
+   pipeline_threads(std::atomic<bool>& stop, 
+                    Drain& drain)
+      : m_stop(stop), 
+        m_drain(drain) { }
+   ~pipeline_threads(void) { join(); }
+   pipeline_threads(pipeline_threads&) = delete; 
+   pipeline_threads& operator = (pipeline_threads&) = delete; 
+
+   /**********************************************************************************************
+   * start: Startar en ny tolkningstråd, som exekverar angiven funktion med angivna argument.
+   *
+   *        - function: Funktionen som skall exekveras.
+   *        - args    : Argument till funktionen.
+   **********************************************************************************************/
+   template <typename Function, typename... Args>
+   void start(Function&& function, 
+              Args&&... args)
+   {
+      m_threads.emplace_back(std::forward<Function>(function), std::forward<Args>(args)...);
+      return;
+   }
+
+   /**********************************************************************************************
+   * join: Signalerar samtliga startade tolkningstrådar att avsluta, tömmer deras 
+   *       ringbuffertar fram till slutmarkeringen och sammanfogar dem.
+   **********************************************************************************************/
+   void join(void)
+   {
+      m_stop.store(true, std::memory_order_relaxed);
+
+      for (std::size_t i = 0; i < m_threads.size(); ++i)
+      {
+         m_drain(i);
+      }
+
+      for (auto& i : m_threads)
+      {
+         i.join();
+      }
+
+      m_threads.clear();
+      return;
+   }
+};
+
+/* Statiska funktioner: */
+static void push_wait(spsc_queue<pipeline_chunk*>& queue, 
+                      pipeline_chunk* chunk);
+static pipeline_chunk* pop_wait(spsc_queue<pipeline_chunk*>& queue);
+
+/**************************************************************************************************
+* optimize: Justerar parametrar för angiven regressionsmodell i syfte att minska aktuellt fel. 
+*           Prediktion genomförs via given insignal, där predikterat värde jämförs mot givet 
+*           referensvärde för att beräkna aktuellt fel. Modellens parametrar justeras sedan med en 
+*           bråkdel av felet, vilket avgörs av lärhastigheten. 
+*
+*           För vikten (k-värdet) tas aktuell insignal i åtanke gällande graden av justering, 
+*           då viktens betydelse för aktuell fel står i direkt proportion med aktuell insignal 
+*           (ju högre insignal, desto mer påverkan har vikten på predikterad utsignal och därmed 
+*           eventuellt fel).
+* 
+*           Parametrarna passeras via referens, vilket gör att träningslooparna i basklassen 
+*           kan hålla dessa i lokala variabler under en epok. Det kvadrerade felet returneras 
+*           och adderas av anroparen till epokens förlust, vilket gör att förlusten kan följas 
+*           utan någon extra genomgång av träningsdatan. Vid standardisering används den 
+*           standardiserade insignalen för viktens gradient, se update_parameters.
+* 
+*           - input    : Insignal från träningsdata som används för att genomföra prediktion.
+*           - reference: Referensvärde från träningsdatan, som används för att beräkna aktuellt
+*                        fel via jämförelse med predikterat värde.
+*           - weight   : Referens till vikten som skall justeras.
+*           - bias     : Referens till vilovärdet som skall justeras.
+**************************************************************************************************/
+double lin_reg::optimize(const double input, 
+                         const double reference,
+                         double& weight,
+                         double& bias)
+{
+   const auto prediction = weight * input + bias;
+   const auto error = reference - prediction;
+   update_parameters(error * (input - m_shift) * m_scale, error, weight, bias);
+   return error * error;
+}
+
+/**************************************************************************************************
+* update_parameters: Justerar parametrarna för angiven regressionsmodell utifrån angivna 
+*                    nedstigningsriktningar, som omvandlas till steg via vald metod för 
+*                    justering samt aktuell lärhastighet. Vid vanlig stokastisk 
+*                    gradientnedstigning multipliceras riktningarna direkt med lärhastigheten.
+*
+*                    Vid standardisering av insignalerna avser riktningarna parametrarna för 
+*                    den standardiserade insignalen x' = (x - m_shift) * m_scale. Stegen räknas 
+*                    om till motsvarande steg för den ursprungliga insignalen, vilket gör att 
+*                    modellens parametrar alltid avser ursprunglig skala och att ingen 
+*                    standardiserad kopia av träningsdatan behöver skapas. Utan standardisering 
+*                    är m_shift noll och m_scale ett, vilket ger oförändrade steg.
+*
+*                    - weight_step: Nedstigningsriktning för vikten.
+*                    - bias_step  : Nedstigningsriktning för vilovärdet.
+*                    - weight     : Referens till vikten som skall justeras.
+*                    - bias       : Referens till vilovärdet som skall justeras.
+**************************************************************************************************/
+void lin_reg::update_parameters(double weight_step, 
+                                double bias_step,
+                                double& weight,
+                                double& bias)
+{
+   if (m_optimizer.mode() == optimizer_mode::sgd)
+   {
+      weight_step *= m_rate;
+      bias_step *= m_rate;
+   }
+   else
+   {
+      m_optimizer.update(weight_step, bias_step, m_rate);
+   }
+
+   weight_step *= m_scale;
+   weight += weight_step;
+   bias += bias_step - m_shift * weight_step;
+   return;
+}
+
+/**************************************************************************************************
+* optimize_batch: Justerar parametrar för angiven regressionsmodell utifrån medelvärdet av 
+*                 gradienterna för en minibatch, bestående av angivet antal sammanhängande 
+*                 träningsuppsättningar, exempelvis en del av vektorerna m_train_in samt 
+*                 m_train_out. Gradienterna beräknas via en vektoriserad beräkningskärna.
+*
+*                 Vid parallell träning delas minibatchen upp i lika stora delar, där varje 
+*                 tråd beräknar delsummor för sin del. Delsummorna slås sedan ihop parvis i 
+*                 form av ett träd i en fast ordning, vilket medför att resultatet är 
+*                 deterministiskt för ett givet antal trådar. Summan av de kvadrerade felen 
+*                 beräknas i samma genomgång och adderas till epokens förlust. Vid 
+*                 standardisering beräknas gradienten för den standardiserade insignalen 
+*                 direkt ur summorna, eftersom summan av fel gånger (x - m_shift) är lika med 
+*                 summan av fel gånger x minus m_shift gånger summan av felen.
+*
+*                 - input   : Insignaler för minibatchens träningsuppsättningar.
+*                 - output  : Referensvärden för minibatchens träningsuppsättningar.
+*                 - num_sets: Antalet träningsuppsättningar i minibatchen.
+*                 - weight  : Referens till vikten som skall justeras.
+*                 - bias    : Referens till vilovärdet som skall justeras.
+**************************************************************************************************/
+void lin_reg::optimize_batch(const double* input, 
+                             const double* output,
+                             const std::size_t num_sets,
+                             double& weight,
+                             double& bias)
+{
+   double sum_error, sum_error_input, sum_squared_error;
+   const auto shards = num_shards(num_sets);
+
+   if (shards == 1)
+   {
+      batch_gradient(input, output, num_sets, weight, bias, 
+                     sum_error, sum_error_input, sum_squared_error);
+   }
+   else
+   {
+      const auto shard_size = (num_sets + shards - 1) / shards;
+
+      m_pool->run(shards, [&](const std::size_t i)
+      {
+         const auto begin = i * shard_size;
+         const auto end = begin + shard_size < num_sets ? begin + shard_size : num_sets;
+         batch_gradient(&input[begin], &output[begin], end - begin, weight, bias, 
+                        m_partial_error[i], m_partial_error_input[i], m_partial_loss[i]);
+      });
+
+      for (std::size_t stride = 1; stride < shards; stride *= 2)
+      {
+         for (std::size_t i = 0; i + stride < shards; i += 2 * stride)
+         {
+            m_partial_error[i] += m_partial_error[i + stride];
+            m_partial_error_input[i] += m_partial_error_input[i + stride];
+            m_partial_loss[i] += m_partial_loss[i + stride];
+         }
+      }
+
+      sum_error = m_partial_error[0];
+      sum_error_input = m_partial_error_input[0];
+      sum_squared_error = m_partial_loss[0];
+   }
+
+   m_loss_sum += sum_squared_error;
+   m_loss_count += num_sets;
+
+   const auto inverse = 1.0 / num_sets;
+   update_parameters((sum_error_input - m_shift * sum_error) * m_scale * inverse, 
+                     sum_error * inverse, weight, bias);
+   return;
+}
+
+/**************************************************************************************************
+* init_thread_pool: Skapar en trådpool med angivet antal trådar inför parallell träning, ifall 
+*                   fler än en tråd skall användas och ingen sådan trådpool redan finns. När en 
+*                   ny trådpool skapas mäts även minsta lönsamma antal träningsuppsättningar 
+*                   per tråd upp, se calibrate_shards. Plats för delsummor per tråd allokeras 
+*                   också, så att ingen allokering sker under själva träningen.
+**************************************************************************************************/
+void lin_reg::init_thread_pool(void)
+{
+   m_partial_error.resize(m_num_threads);
+   m_partial_error_input.resize(m_num_threads);
+   m_partial_loss.resize(m_num_threads);
+
+   if (m_num_threads > 1 && (!m_pool || m_pool->size() != m_num_threads))
+   {
+      m_pool = std::make_unique<thread_pool>(m_num_threads);
+      calibrate_shards();
+   }
+   return;
+}
+
+/**************************************************************************************************
+* calibrate_shards: Mäter upp minsta antal träningsuppsättningar per tråd vid parallell träning, 
+*                   ifall inget sådant antal har angivits via set_min_shard_size. Gradienten för 
+*                   calibration_rows träningsuppsättningar per tråd beräknas först sekventiellt 
+*                   och sedan parallellt via trådpoolen, där den snabbaste av flera omgångar 
+*                   används. Skillnaden mellan den parallella tiden och den ideala tiden utgör 
+*                   kostnaden för att starta samt synkronisera trådarna, medan den sekventiella 
+*                   tiden ger kostnaden per träningsuppsättning. Varje del måste sedan innehålla 
+*                   så många träningsuppsättningar att beräkningen tar minst shard_cost_ratio 
+*                   gånger så lång tid som synkroniseringen, dock minst shard_granularity. Ifall 
+*                   den parallella beräkningen inte är minst min_parallel_speedup gånger så 
+*                   snabb som den sekventiella, exempelvis då datorn enbart har en 
+*                   processorkärna, delas träningsdatan aldrig upp.
+*
+*                   Mätningen sker en gång per trådpool, vilket gör att antalet delar är 
+*                   detsamma för samtliga träningar med samma trådpool.
+**************************************************************************************************/
+void lin_reg::calibrate_shards(void)
+{
+   if (m_min_shard_size > 0)
+   {
+      m_shard_size = m_min_shard_size;
+      return;
+   }
+
+   using clock = std::chrono::steady_clock;
+   const std::vector<double> sample(m_num_threads * calibration_rows, 1.0);
+   auto sequential = std::chrono::duration<double>::max();
+   auto parallel = std::chrono::duration<double>::max();
+
+   auto gradient = [&](const std::size_t i)
+   {
+      batch_gradient(&sample[i * calibration_rows], &sample[i * calibration_rows], 
+                     calibration_rows, 1.0, 0.0, m_partial_error[i], 
+                     m_partial_error_input[i], m_partial_loss[i]);
+   };
+
+   for (std::size_t round = 0; round < calibration_rounds; ++round)
+   {
+      auto start = clock::now();
+      for (std::size_t i = 0; i < m_num_threads; ++i) gradient(i);
+      const std::chrono::duration<double> elapsed = clock::now() - start;
+      if (elapsed < sequential) sequential = elapsed;
+
+      start = clock::now();
+      m_pool->run(m_num_threads, gradient);
+      const std::chrono::duration<double> elapsed_parallel = clock::now() - start;
+      if (elapsed_parallel < parallel) parallel = elapsed_parallel;
+   }
+
+   if (parallel.count() * min_parallel_speedup >= sequential.count())
+   {
+      m_shard_size = static_cast<std::size_t>(-1);
+      return;
+   }
+
+   const auto row_cost = sequential.count() / (m_num_threads * calibration_rows);
+   const auto overhead = parallel.count() - sequential.count() / m_num_threads;
+   const auto rows = overhead > 0 ? shard_cost_ratio * overhead / row_cost : 0.0;
+
+   m_shard_size = rows > shard_granularity ? static_cast<std::size_t>(rows) : shard_granularity;
+   return;
+}
+
+/**************************************************************************************************
+* num_shards: Returnerar antalet delar som angivet antal träningsuppsättningar skall delas upp i 
+*             vid parallell träning. Varje del innehåller minst m_shard_size 
+*             träningsuppsättningar, eftersom synkroniseringen av trådarna annars tar längre 
+*             tid än själva beräkningen, se calibrate_shards. För en given trådpool avgörs 
+*             antalet delar enbart av antalet träningsuppsättningar, vilket ger deterministiska 
+*             resultat. Mellan körningar kan den uppmätta gränsen dock variera, vilket kan 
+*             förhindras genom att ange gränsen via set_min_shard_size.
+*
+*             - num_sets: Antalet träningsuppsättningar som skall behandlas.
+**************************************************************************************************/
+std::size_t lin_reg::num_shards(const std::size_t num_sets)
+{
+   if (!m_pool) return 1;
+   const auto shards = num_sets / m_shard_size;
+   if (shards < 1) return 1;
+   return shards < m_num_threads ? shards : m_num_threads;
+}
+
+/**************************************************************************************************
+* lin_reg: Konstruktor för klassen lin_reg, vilket används för att initiera en ny 
+*          regressionsmodell som baseras på linjär regression. Angivet antal epoker samt 
+*          lärhastighet lagras inför träning av basklassen. Träningsdata måste dock tillföras i 
+*          efterhand via någon av medlemsfunktioner load_training_data (för att läsa in 
+*          träningsuppsättingarna från en fil) eller set_training_data (för att passera 
+*          träningsdata via referenser till vektorer). Vektorerna för träningsdatan allokeras 
+*          via angiven minnesresurs.
+* 
+*          - num_epochs   : Antalet epoker/omgångar som skall genomföras vid träning.
+*          - learning_rate: Lärhastighet, avgör med hur stor andel av aktuellt fel som
+*                           modellens parametrar (bias och vikt) skall justeras.
+*          - resource     : Minnesresurs för träningsdatan (default = 
+*                           std::pmr::get_default_resource()).
+**************************************************************************************************/
+lin_reg::lin_reg(const std::size_t num_epochs, 
+                 const double learning_rate, 
+                 std::pmr::memory_resource* resource)
+   : basic_lin_reg(num_epochs, learning_rate, 1, resource)
+{
+}
+
+/**************************************************************************************************
+* lin_reg: Konstruktor för klassen lin_reg, där träningsdatan allokeras via angiven minnesresurs, 
+*          exempelvis en arena (std::pmr::monotonic_buffer_resource) eller en resurs som 
+*          allokerar stora sidor. Minnesresursen måste leva längre än regressionsmodellen.
+*
+*          - resource: Minnesresurs för vektorerna med träningsdata.
+**************************************************************************************************/
+lin_reg::lin_reg(std::pmr::memory_resource* resource)
+   : basic_lin_reg(resource)
+{
+}
+
+/**************************************************************************************************
+* lin_reg: Förflyttningskonstruktor, som medför förflyttning av minne från en 
+*          regressionsmodell till en annan, i detta fall från source till angivet objekt this 
+*          via anrop av funktionen std::move.
+* 
+*          Basklassens medlemmar, inklusive träningsdatan och dess minnesresurs, förflyttas av 
+*          basklassens förflyttningskonstruktor utan att något minne allokeras eller kopieras, 
+*          varefter övriga medlemmar förflyttas och source nollställs. Efter förflyttningen har 
+*          därmed enbart angiven modell this tillgång till minnet i fråga.
+* 
+*          - source: Den regressionsmodell som minnet skall förflyttas från.
+**************************************************************************************************/
+lin_reg::lin_reg(lin_reg&& source) noexcept
+   : basic_lin_reg(std::move(source))
+{
+   move_from(source);
+}
+
+/**************************************************************************************************
+* operator =: Förflyttar innehållet i regressionsmodellen source till angivet objekt this, 
+*             varefter source nollställs. Angiven modell behåller sin minnesresurs för 
+*             träningsdatan. Ifall båda modellerna använder samma minnesresurs, vilket gäller 
+*             som default, förflyttas träningsdatan utan att minne allokeras eller kopieras. 
+*             Annars kopieras träningsdatan till minne från angiven modells resurs.
+*
+*             - source: Den regressionsmodell som minnet skall förflyttas från.
+**************************************************************************************************/
+lin_reg& lin_reg::operator = (lin_reg&& source)
+{
+   if (this != &source)
+   {
+      basic_lin_reg::operator = (std::move(source));
+      move_from(source);
+   }
+   return *this;
+}
+
+/**************************************************************************************************
+* move_from: Förflyttar samtliga medlemmar som inte tillhör basklassen från 
+*            regressionsmodellen source till angivet objekt this och nollställer därefter 
+*            source, vilket används av förflyttningskonstruktorn samt tilldelningsoperatorn 
+*            efter att basklassens medlemmar har förflyttats.
+*
+*            - source: Den regressionsmodell som medlemmarna skall förflyttas från.
+**************************************************************************************************/
+void lin_reg::move_from(lin_reg& source) noexcept
+{
+   m_solver = source.m_solver;
+   m_num_threads = source.m_num_threads;
+   m_min_shard_size = source.m_min_shard_size;
+   m_shard_size = source.m_shard_size;
+   m_pool = std::move(source.m_pool);
+   m_partial_error = std::move(source.m_partial_error);
+   m_partial_error_input = std::move(source.m_partial_error_input);
+   m_partial_loss = std::move(source.m_partial_loss);
+   m_partial_stats = std::move(source.m_partial_stats);
+   m_chunk_in = std::move(source.m_chunk_in);
+   m_chunk_out = std::move(source.m_chunk_out);
+   m_tolerance = source.m_tolerance;
+   m_patience = source.m_patience;
+   m_validation_split = source.m_validation_split;
+   m_num_validation = source.m_num_validation;
+   m_split_version = source.m_split_version;
+   m_split_size = source.m_split_size;
+   m_epochs_run = source.m_epochs_run;
+   m_num_stalled = source.m_num_stalled;
+   m_best_loss = source.m_best_loss;
+   m_prev_weight = source.m_prev_weight;
+   m_prev_bias = source.m_prev_bias;
+   m_loss_sum = source.m_loss_sum;
+   m_loss_count = source.m_loss_count;
+   m_loss_history = std::move(source.m_loss_history);
+   m_validation_loss_history = std::move(source.m_validation_loss_history);
+   m_optimizer = source.m_optimizer;
+   m_rate = source.m_rate;
+   m_standardize = source.m_standardize;
+   m_input_stats = source.m_input_stats;
+   m_shift = source.m_shift;
+   m_scale = source.m_scale;
+   m_stats = source.m_stats;
+
+   source.m_partial_error.clear();
+   source.m_partial_error_input.clear();
+   source.m_partial_loss.clear();
+   source.m_partial_stats.clear();
+   source.m_chunk_in.clear();
+   source.m_chunk_out.clear();
+   source.m_loss_history.clear();
+   source.m_validation_loss_history.clear();
+   source.m_solver = solver_mode::sgd;
+   source.m_num_threads = 1;
+   source.m_min_shard_size = 0;
+   source.m_tolerance = 0;
+   source.m_patience = 5;
+   source.m_validation_split = 0;
+   source.m_num_validation = 0;
+   source.m_split_version = 0;
+   source.m_split_size = 0;
+   source.m_epochs_run = 0;
+   source.m_num_stalled = 0;
+   source.m_optimizer = optimizer();
+   source.m_rate = 0;
+   source.m_standardize = false;
+   source.m_input_stats.clear();
+   source.m_shift = 0;
+   source.m_scale = 1;
+   source.m_stats.clear();
+   return;
+}
+
+/**************************************************************************************************
+* set_solver: Väljer lösningsmetod vid träning av angiven regressionsmodell, antingen stokastisk
+*             gradientnedstigning (solver_mode::sgd) eller exakt minstakvadratlösning
+*             (solver_mode::closed_form).
+*
+*             - solver: Den lösningsmetod som skall användas vid träning.
+**************************************************************************************************/
+void lin_reg::set_solver(const solver_mode solver)
+{
+   m_solver = solver;
+   return;
+}
+
+/**************************************************************************************************
+* set_num_threads: Sätter antalet trådar som används vid träning ifall angivet nytt värde 
+*                  överstiger noll. Parallell träning används för minibatcher samt för den 
+*                  exakta minstakvadratlösningen, medan stokastisk gradientnedstigning med en 
+*                  batchstorlek på ett alltid sker i en tråd.
+*
+*                  - num_threads: Det nya antalet trådar som skall användas vid träning.
+**************************************************************************************************/
+void lin_reg::set_num_threads(const std::size_t num_threads)
+{
+   if (num_threads > 0)
+   {
+      m_num_threads = num_threads;
+      if (num_threads == 1) m_pool.reset();
+   }
+   return;
+}
+
+/**************************************************************************************************
+* set_min_shard_size: Sätter minsta antal träningsuppsättningar per tråd vid parallell träning. 
+*                     Som default mäts gränsen upp när trådpoolen skapas, men en fast gräns ger 
+*                     samma uppdelning, och därmed samma resultat, oavsett dator. Ett värde på 
+*                     noll medför att gränsen åter mäts upp.
+*
+*                     - min_shard_size: Minsta antal träningsuppsättningar per tråd.
+**************************************************************************************************/
+void lin_reg::set_min_shard_size(const std::size_t min_shard_size)
+{
+   m_min_shard_size = min_shard_size;
+   if (m_pool) calibrate_shards();
+   return;
+}
+
+/**************************************************************************************************
+* set_early_stopping: Aktiverar tidigt avbrott av träningen när angiven regressionsmodell har 
+*                     konvergerat. En epok räknas som utan förbättring ifall den övervakade 
+*                     förlusten minskar med en relativ andel som understiger angiven tolerans 
+*                     jämfört med den lägsta förlusten hittills, eller ifall parametrarnas 
+*                     sammanlagda förändring under epoken understiger toleransen relativt 
+*                     parametrarnas storlek. Träningen avbryts efter angivet antal epoker i följd 
+*                     utan förbättring. En tolerans på noll stänger av tidigt avbrott.
+*
+*                     - tolerance: Tolerans för konvergens (noll = avstängd).
+*                     - patience : Antalet epoker i följd utan förbättring innan träningen 
+*                                  avbryts (default = 5).
+**************************************************************************************************/
+void lin_reg::set_early_stopping(const double tolerance, 
+                                 const std::size_t patience)
+{
+   if (tolerance >= 0)
+   {
+      m_tolerance = tolerance;
+      m_patience = patience > 0 ? patience : 1;
+   }
+   return;
+}
+
+/**************************************************************************************************
+* set_validation_split: Sätter andelen träningsuppsättningar som hålls utanför träningen och 
+*                       i stället används för att beräkna valideringsförlusten efter varje epok, 
+*                       ifall angivet värde ligger inom intervallet [0, 1). När en andel har 
+*                       angivits övervakas valideringsförlusten i stället för träningsförlusten 
+*                       vid tidigt avbrott. Valideringen sker enbart vid träning via train, 
+*                       eftersom träningsdatan inte lagras vid strömmande träning.
+*
+*                       - fraction: Andelen träningsuppsättningar för validering.
+**************************************************************************************************/
+void lin_reg::set_validation_split(const double fraction)
+{
+   if (fraction >= 0 && fraction < 1)
+   {
+      m_validation_split = fraction;
+   }
+   return;
+}
+
+/**************************************************************************************************
+* set_optimizer: Väljer metod för justering av parametrarna vid träning via stokastisk 
+*                gradientnedstigning. Utöver vanlig gradientnedstigning (optimizer_mode::sgd) 
+*                kan momentum, Nesterov, AdaGrad, RMSProp samt Adam användas, vilka i regel 
+*                konvergerar på betydligt färre epoker, särskilt vid dåligt skalade insignaler. 
+*                Tillståndet för adaptiva metoder nollställs inför varje ny träning.
+*
+*                - mode : Metod för justering.
+*                - beta1: Avtagandefaktor för första momentet (default = 0.9).
+*                - beta2: Avtagandefaktor för andra momentet (default = 0.999).
+**************************************************************************************************/
+void lin_reg::set_optimizer(const optimizer_mode mode, 
+                            const double beta1, 
+                            const double beta2)
+{
+   m_optimizer.set_mode(mode, beta1, beta2);
+   return;
+}
+
+/**************************************************************************************************
+* set_schedule: Väljer schema för lärhastigheten, som utvärderas inför varje epok utifrån 
+*               lärhastigheten angiven via set_learning_rate. Som default är lärhastigheten 
+*               konstant under hela träningen.
+*
+*               - schedule : Schema för lärhastigheten.
+*               - gamma    : Multiplikator vid stegvis samt exponentiellt schema (default = 0.1).
+*               - step_size: Antalet epoker per steg vid stegvis schema (default = 10).
+**************************************************************************************************/
+void lin_reg::set_schedule(const schedule_mode schedule, 
+                           const double gamma, 
+                           const std::size_t step_size)
+{
+   m_optimizer.set_schedule(schedule, gamma, step_size);
+   return;
+}
+
+/**************************************************************************************************
+* set_standardization: Aktiverar eller inaktiverar automatisk standardisering av insignalerna 
+*                      vid träning via stokastisk gradientnedstigning. Insignalernas medelvärde 
+*                      samt standardavvikelse beräknas före träningen, alternativt löpande under 
+*                      den första epoken vid strömmande träning, och tillämpas direkt i 
+*                      gradientberäkningen utan att träningsdatan förändras. Modellens parametrar 
+*                      avser alltid insignalernas ursprungliga skala.
+*
+*                      - standardize: Indikerar ifall insignalerna skall standardiseras.
+**************************************************************************************************/
+void lin_reg::set_standardization(const bool standardize)
+{
+   m_standardize = standardize;
+   return;
+}
+
+/**************************************************************************************************
+* train: Tränar angiven regressionsmodell via vald lösningsmetod. Som default används stokastisk
+*        gradientnedstigning under angivet antal epoker, men den exakta minstakvadratlösningen
+*        kan också beräknas via en enda genomgång av träningsdatan. Ifall fler än en tråd har 
+*        angivits via set_num_threads skapas först en trådpool för parallell träning.
+*
+*        Vid stokastisk gradientnedstigning avbryts träningen i förtid ifall modellen har 
+*        konvergerat, se set_early_stopping. Antalet genomförda epoker kan läsas via epochs_run. 
+*        Den tillräckliga statistiken för den exakta lösningen ackumuleras för samtliga 
+*        träningsuppsättningar oavsett lösningsmetod, se partial_fit.
+**************************************************************************************************/
+void lin_reg::train(void)
+{
+   init_thread_pool();
+   begin_training();
+
+   if (m_solver == solver_mode::closed_form)
+   {
+      train_closed_form();
+      m_epochs_run = 1;
+   }
+   else
+   {
+      split_validation();
+      if (m_standardize)
+      {
+         update_standardization(m_train_in.data(), m_train_out.data(), 
+                                m_train_in.size() - m_num_validation);
+      }
+
+      for (std::size_t i = 0; i < m_train_in.size(); ++i)
+      {
+         m_stats.add(m_train_in[i], m_train_out[i]);
+      }
+      train_sgd();
+   }
+   return;
+}
+
+/**************************************************************************************************
+* begin_training: Nollställer räknare, förlustkurvor samt tillstånd för konvergenskontroll 
+*                 inför en ny träning av angiven regressionsmodell. Plats för förlustkurvorna 
+*                 reserveras för samtliga epoker, så att ingen allokering sker under träningen.
+**************************************************************************************************/
+void lin_reg::begin_training(void)
+{
+   m_epochs_run = 0;
+   m_num_stalled = 0;
+   m_num_validation = 0;
+   m_best_loss = 0;
+   m_prev_weight = m_weights[0];
+   m_prev_bias = m_bias;
+   m_loss_sum = 0;
+   m_loss_count = 0;
+   m_loss_history.clear();
+   m_validation_loss_history.clear();
+   m_loss_history.reserve(m_num_epochs);
+   m_optimizer.reset();
+   m_input_stats.clear();
+   m_stats.clear();
+   m_shift = 0;
+   m_scale = 1;
+   m_rate = m_learning_rate;
+   return;
+}
+
+/**************************************************************************************************
+* begin_epoch: Beräknar lärhastigheten för angiven epok enligt valt schema samt startar 
+*              tidtagningen för epoken.
+*
+*              - epoch: Index för epoken, där den första epoken har index 0.
+**************************************************************************************************/
+void lin_reg::begin_epoch(const std::size_t epoch)
+{
+   m_rate = m_optimizer.rate(m_learning_rate, epoch, m_num_epochs);
+   m_instrumentation.begin_epoch();
+   return;
+}
+
+/**************************************************************************************************
+* update_standardization: Lägger till angivna träningsuppsättningar i statistiken för 
+*                         insignalerna och uppdaterar därefter parametrarna för standardisering 
+*                         via refresh_standardization.
+*
+*                         - input   : Insignaler för träningsuppsättningarna.
+*                         - output  : Utsignaler för träningsuppsättningarna.
+*                         - num_sets: Antalet träningsuppsättningar.
+**************************************************************************************************/
+void lin_reg::update_standardization(const double* input, 
+                                     const double* output,
+                                     const std::size_t num_sets)
+{
+   for (std::size_t i = 0; i < num_sets; ++i)
+   {
+      m_input_stats.add(input[i], output[i]);
+   }
+
+   refresh_standardization();
+   return;
+}
+
+/**************************************************************************************************
+* refresh_standardization: Sätter medelvärdet m_shift samt inversen av standardavvikelsen 
+*                          m_scale som används vid standardisering utifrån statistiken för 
+*                          insignalerna. Ifall samtliga insignaler är lika används skalan ett.
+**************************************************************************************************/
+void lin_reg::refresh_standardization(void)
+{
+   const auto variance = m_input_stats.variance_x();
+   m_shift = m_input_stats.mean_x();
+   m_scale = variance > 0 ? 1 / std::sqrt(variance) : 1;
+   return;
+}
+
+/**************************************************************************************************
+* split_validation: Väljer slumpmässigt ut angiven andel av träningsuppsättningarna för 
+*                   validering och flyttar dessa till slutet av vektorerna m_train_in samt 
+*                   m_train_out via en partiell Fisher-Yates-blandning. Därmed utgör både 
+*                   tränings- och valideringsdatan sammanhängande minnesområden, vilket gör 
+*                   att minibatcher och valideringsförlust kan beräknas utan indirekt 
+*                   indexering. Minst en träningsuppsättning lämnas alltid kvar för träning.
+*
+*                   Uppdelningen sker enbart en gång per träningsdata och andel, vilket avgörs 
+*                   via basklassens räknare m_data_version. Upprepade anrop av train använder 
+*                   därmed samma valideringsdata, utan att träningsdatan ordnas om på nytt.
+**************************************************************************************************/
+void lin_reg::split_validation(void)
+{
+   const auto num_sets = m_train_in.size();
+   m_num_validation = static_cast<std::size_t>(num_sets * m_validation_split);
+
+   if (m_num_validation >= num_sets)
+   {
+      m_num_validation = num_sets > 0 ? num_sets - 1 : 0;
+   }
+
+   if (m_split_version != m_data_version || m_split_size != m_num_validation)
+   {
+      for (auto i = num_sets; i > num_sets - m_num_validation; --i)
+      {
+         const auto j = m_shuffler.bounded(i);
+         std::swap(m_train_in[i - 1], m_train_in[j]);
+         std::swap(m_train_out[i - 1], m_train_out[j]);
+      }
+
+      m_split_version = m_data_version;
+      m_split_size = m_num_validation;
+   }
+
+   m_validation_loss_history.reserve(m_num_validation > 0 ? m_num_epochs : 0);
+   return;
+}
+
+/**************************************************************************************************
+* validation_loss: Returnerar medelkvadratfelet för angiven regressionsmodell över de 
+*                  träningsuppsättningar som hållits utanför träningen för validering.
+**************************************************************************************************/
+double lin_reg::validation_loss(void)
+{
+   const auto first = m_train_in.size() - m_num_validation;
+   double sum_error, sum_error_input, sum_squared_error;
+   batch_gradient(&m_train_in[first], &m_train_out[first], m_num_validation, m_weights[0], m_bias,
+                  sum_error, sum_error_input, sum_squared_error);
+   return sum_squared_error / m_num_validation;
+}
+
+/**************************************************************************************************
+* end_epoch: Avslutar en epok genom att lagra epokens träningsförlust, beräknad som 
+*            medelkvadratfelet för de fel som uppstod under själva träningen, samt i 
+*            förekommande fall valideringsförlusten, vilka även registreras i statistiken för 
+*            tidsåtgång samt genomströmning. Därefter kontrolleras ifall modellen har 
+*            konvergerat enligt angiven tolerans. Returnerar true ifall träningen skall avbrytas.
+**************************************************************************************************/
+bool lin_reg::end_epoch(void)
+{
+   const auto loss = m_loss_count > 0 ? m_loss_sum / m_loss_count : 0.0;
+   const auto num_rows = m_loss_count;
+   auto monitored = loss;
+
+   m_loss_history.push_back(loss);
+   m_loss_sum = 0;
+   m_loss_count = 0;
+   m_epochs_run++;
+
+   if (m_num_validation > 0)
+   {
+      monitored = validation_loss();
+      m_validation_loss_history.push_back(monitored);
+   }
+
+   m_instrumentation.end_epoch(num_rows, loss, m_num_validation > 0 ? monitored : 0.0);
+
+   if (m_tolerance <= 0) return false;
+
+   const auto delta = std::abs(m_weights[0] - m_prev_weight) + std::abs(m_bias - m_prev_bias);
+   const auto scale = std::abs(m_weights[0]) + std::abs(m_bias) + 1;
+   const auto improved = m_epochs_run == 1 || monitored < m_best_loss * (1 - m_tolerance);
+
+   if (m_epochs_run == 1 || monitored < m_best_loss) m_best_loss = monitored;
+   m_prev_weight = m_weights[0];
+   m_prev_bias = m_bias;
+
+   m_num_stalled = improved && delta > m_tolerance * scale ? 0 : m_num_stalled + 1;
+   return m_num_stalled >= m_patience;
+}
+
+/**************************************************************************************************
+* train_sgd: Tränar angiven regressionsmodell under angivet antal epoker. Inför varje ny epok 
+*            randomiseras ordningsföljden på träningsuppsättningarna för att undvika att 
+*            eventuella mönster som uppträder i träningsdatan skall påverka träningen av modellen. 
+*
+*            Varje varv optimeras modellens parametrar genom att en prediktion genomförs via en 
+*            insignal från träningsdatan, där det predikterade värdet jämförs med referensvärdet 
+*            från träningsdatan. Differensen mellan dessa värden utgör aktuellt fel och 
+*            parametrarna justeras med en bråkdel av detta värde, beroende på aktuell 
+*            lärhastighet.
+*
+*            Själva looparna tillhandahålls av basklassen, antingen per träningsuppsättning via 
+*            train_single eller via minibatcher av sammanhängande träningsuppsättningar via 
+*            train_mini_batch, medan justeringen via vald metod, schemat för lärhastigheten, 
+*            förlusten samt kontrollen för tidigt avbrott passeras som funktioner. 
+*            Träningsuppsättningar som hållits utanför träningen för validering ingår inte i 
+*            ordningsföljden under träningen, som därefter återställs till samtliga 
+*            träningsuppsättningar.
+**************************************************************************************************/
+void lin_reg::train_sgd(void)
+{
+   const auto num_sets = m_train_out.size() - m_num_validation;
+   const auto begin = [this](const std::size_t epoch) { begin_epoch(epoch); };
+
+   if (m_batch_size > 1)
+   {
+      train_mini_batch(num_sets, [this](const std::size_t first, 
+                                        const std::size_t size, 
+                                        double* weights, 
+                                        double& bias)
+      {
+         optimize_batch(&m_train_in[first], &m_train_out[first], size, weights[0], bias);
+      }, begin, [this](void) { return end_epoch(); });
+   }
+   else
+   {
+      train_single(num_sets, [this](const std::size_t index, double* weights, double& bias)
+      {
+         m_loss_sum += optimize(m_train_in[index], m_train_out[index], weights[0], bias);
+      }, begin, [this, num_sets](void)
+      {
+         m_loss_count += num_sets;
+         return end_epoch();
+      });
+   }
+   return;
+}
+
+/**************************************************************************************************
+* train_closed_form: Beräknar den exakta minstakvadratlösningen för angiven regressionsmodell via
+*                    en sekventiell genomgång av träningsdatan. Medelvärden samt centrerade 
+*                    kvadratsummor ackumuleras enligt Welfords metod, vilket är numeriskt 
+*                    stabilt även för miljontals träningsuppsättningar. Varken antalet epoker 
+*                    eller lärhastigheten används. Ifall träningsdata saknas lämnas modellens
+*                    parametrar oförändrade.
+*
+*                    Vid parallell träning ackumulerar varje tråd statistik för en del av 
+*                    träningsdatan, varefter statistiken slås ihop parvis i form av ett träd. 
+*                    Statistiken per tråd lagras i m_partial_stats, som återanvänds mellan 
+*                    träningarna, så att ingen allokering sker efter den första träningen.
+**************************************************************************************************/
+void lin_reg::train_closed_form(void)
+{
+   const auto num_sets = m_train_in.size();
+   const auto shards = num_shards(num_sets);
+   const auto shard_size = (num_sets + shards - 1) / shards;
+   auto& stats = m_partial_stats;
+   stats.resize(shards);
+
+   auto accumulate = [&](const std::size_t i)
+   {
+      const auto begin = i * shard_size;
+      const auto end = begin + shard_size < num_sets ? begin + shard_size : num_sets;
+      regression_stats local;
+
+      for (auto j = begin; j < end; ++j)
+      {
+         local.add(m_train_in[j], m_train_out[j]);
+      }
+
+      stats[i] = local;
+   };
+
+   if (shards == 1)
+   {
+      accumulate(0);
+   }
+   else
+   {
+      m_pool->run(shards, accumulate);
+
+      for (std::size_t stride = 1; stride < shards; stride *= 2)
+      {
+         for (std::size_t i = 0; i + stride < shards; i += 2 * stride)
+         {
+            stats[i].merge(stats[i + stride]);
+         }
+      }
+   }
+
+   m_stats = stats[0];
+
+   if (m_stats.count() > 0)
+   {
+      m_weights[0] = m_stats.slope();
+      m_bias = m_stats.intercept();
+   }
+   return;
+}
+
+/**************************************************************************************************
+* train_indexed: Tränar angiven regressionsmodell på en delmängd av extern träningsdata, där 
+*                delmängden anges via index i stället för att datan kopieras till modellen. 
+*                Vektorn order fungerar på samma sätt som m_train_order och randomiseras inför 
+*                varje epok, medan själva träningsdatan enbart läses. Därmed kan flera modeller 
+*                tränas samtidigt på olika delmängder av samma träningsdata, exempelvis vid 
+*                korsvalidering. Modellens egen träningsdata påverkas inte.
+*
+*                Samtliga lösningsmetoder stöds. Vid minibatcher samlas insignaler samt 
+*                utsignaler för varje minibatch in i buffrarna m_chunk_in samt m_chunk_out via 
+*                sina index, varefter gradienterna beräknas vektoriserat. Ingen del av datan 
+*                hålls utanför för validering, eftersom valideringen sköts av anroparen, 
+*                vilket gör att tidigt avbrott övervakar träningsförlusten.
+*
+*                - input : Insignaler för samtliga träningsuppsättningar.
+*                - output: Utsignaler för samtliga träningsuppsättningar.
+*                - order : Index för de träningsuppsättningar som skall användas vid träningen.
+**************************************************************************************************/
+void lin_reg::train_indexed(const double* input, 
+                            const double* output, 
+                            std::vector<std::size_t>& order)
+{
+   begin_training();
+
+   for (const auto j : order)
+   {
+      m_stats.add(input[j], output[j]);
+   }
+
+   if (m_solver == solver_mode::closed_form)
+   {
+      if (m_stats.count() > 0)
+      {
+         m_weights[0] = m_stats.slope();
+         m_bias = m_stats.intercept();
+      }
+
+      m_epochs_run = 1;
+      return;
+   }
+
+   if (m_standardize)
+   {
+      for (const auto j : order)
+      {
+         m_input_stats.add(input[j], output[j]);
+      }
+
+      refresh_standardization();
+   }
+
+   if (m_batch_size > 1)
+   {
+      m_chunk_in.resize(m_batch_size);
+      m_chunk_out.resize(m_batch_size);
+   }
+
+   for (std::size_t i = 0; i < m_num_epochs; ++i)
+   {
+      begin_epoch(i);
+      const auto shuffle_start = m_instrumentation.now();
+      m_shuffler.shuffle(order);
+      m_instrumentation.add_time(training_phase::shuffle, shuffle_start);
+
+      if (m_batch_size > 1)
+      {
+         for (std::size_t first = 0; first < order.size(); first += m_batch_size)
+         {
+            const auto last = first + m_batch_size < order.size() ? first + m_batch_size : order.size();
+
+            for (auto k = first; k < last; ++k)
+            {
+               m_chunk_in[k - first] = input[order[k]];
+               m_chunk_out[k - first] = output[order[k]];
+            }
+
+            optimize_batch(m_chunk_in.data(), m_chunk_out.data(), last - first, m_weights[0], m_bias);
+         }
+      }
+      else
+      {
+         for (const auto j : order)
+         {
+            m_loss_sum += optimize(input[j], output[j], m_weights[0], m_bias);
+         }
+
+         m_loss_count += order.size();
+      }
+
+      if (end_epoch()) break;
+   }
+   return;
+}
+
+/**************************************************************************************************
+* partial_fit: Absorberar en ny träningsuppsättning i angiven regressionsmodell utan att 
+*              träningen startas om, se partial_fit nedan.
+*
+*              - input : Insignal för den nya träningsuppsättningen.
+*              - output: Utsignal för den nya träningsuppsättningen.
+**************************************************************************************************/
+void lin_reg::partial_fit(const double input, 
+                          const double output)
+{
+   partial_fit(&input, &output, 1);
+   return;
+}
+
+/**************************************************************************************************
+* partial_fit: Absorberar angivet antal nya träningsuppsättningar i angiven regressionsmodell 
+*              utan att träningen startas om och utan att träningsuppsättningarna lagras, 
+*              vilket gör att tidsåtgången enbart beror på antalet nya träningsuppsättningar.
+*
+*              Den tillräckliga statistiken m_stats ackumuleras vid varje träning oavsett 
+*              lösningsmetod, vilket gör att den alltid omfattar samtlig absorberad data. Vid 
+*              exakt minstakvadratlösning läggs träningsuppsättningarna till i statistiken, 
+*              varefter lösningen beräknas om. Resultatet blir därmed detsamma som ifall 
+*              modellen hade tränats om på samtlig data, även ifall modellen tidigare har 
+*              tränats via stokastisk gradientnedstigning. Ifall statistiken saknas för en 
+*              tränad modell, exempelvis efter inläsning av en ögonblicksbild av version 1, 
+*              skrivs ett felmeddelande ut och modellen lämnas oförändrad.
+*
+*              Vid stokastisk gradientnedstigning genomförs en genomgång av de nya 
+*              träningsuppsättningarna i angiven ordning, en i taget eller i minibatcher om 
+*              angiven batchstorlek, där förlusten ackumuleras likt vid vanlig träning. 
+*              Lärhastigheten, tillståndet för vald metod för justering samt standardiseringen 
+*              från senaste träningen behålls.
+*
+*              - input   : Array innehållande insignaler för de nya träningsuppsättningarna.
+*              - output  : Array innehållande utsignaler för de nya träningsuppsättningarna.
+*              - num_sets: Antalet nya träningsuppsättningar.
+**************************************************************************************************/
+void lin_reg::partial_fit(const double* input, 
+                          const double* output, 
+                          const std::size_t num_sets)
+{
+   if (m_solver == solver_mode::closed_form && m_stats.count() == 0 && m_epochs_run > 0)
+   {
+      std::cerr << "No sufficient statistics for the trained model, train the model again!\n\n";
+      return;
+   }
+
+   for (std::size_t i = 0; i < num_sets; ++i)
+   {
+      m_stats.add(input[i], output[i]);
+   }
+
+   if (m_solver == solver_mode::closed_form)
+   {
+      if (m_stats.count() > 0)
+      {
+         m_weights[0] = m_stats.slope();
+         m_bias = m_stats.intercept();
+      }
+      return;
+   }
+
+   if (m_rate == 0) m_rate = m_learning_rate;
+
+   if (m_batch_size > 1)
+   {
+      init_thread_pool();
+
+      for (std::size_t i = 0; i < num_sets; i += m_batch_size)
+      {
+         const auto size = num_sets - i < m_batch_size ? num_sets - i : m_batch_size;
+         optimize_batch(&input[i], &output[i], size, m_weights[0], m_bias);
+      }
+   }
+   else
+   {
+      for (std::size_t i = 0; i < num_sets; ++i)
+      {
+         m_loss_sum += optimize(input[i], output[i], m_weights[0], m_bias);
+      }
+
+      m_loss_count += num_sets;
+   }
+   return;
+}
+
+/**************************************************************************************************
+* partial_fit: Absorberar samtliga träningsuppsättningar i refererade vektorer i angiven 
+*              regressionsmodell utan att träningen startas om, se partial_fit ovan. Ifall 
+*              vektorerna har olika storlek används den minsta av dessa.
+*
+*              - input : Vektor innehållande insignaler för de nya träningsuppsättningarna.
+*              - output: Vektor innehållande utsignaler för de nya träningsuppsättningarna.
+**************************************************************************************************/
+void lin_reg::partial_fit(const std::vector<double>& input, 
+                          const std::vector<double>& output)
+{
+   const auto num_sets = input.size() < output.size() ? input.size() : output.size();
+   partial_fit(input.data(), output.data(), num_sets);
+   return;
+}
+
+/**************************************************************************************************
+* train_streaming: Tränar angiven regressionsmodell med träningsdata som läses från angiven 
+*                  inström under träningen, utan att träningsdatan lagras i modellen. Texten 
+*                  läses i block om stream_block_size byte och träningsuppsättningarna samlas i 
+*                  en buffert om buffer_size träningsuppsättningar. När bufferten är full 
+*                  randomiseras ordningsföljden inom bufferten, varefter modellen tränas på 
+*                  innehållet via train_chunk. Minnesåtgången är därmed konstant oavsett 
+*                  träningsdatans storlek, vilket möjliggör träning på datamängder som inte 
+*                  ryms i arbetsminnet. En rad som är längre än ett block räknas som överhoppad 
+*                  och kastas i sin helhet, även de delar som läses i efterföljande block.
+*
+*                  Inför varje ny epok spolas inströmmen tillbaka till början. Ifall detta inte 
+*                  är möjligt, exempelvis vid läsning från standardinenheten, genomförs enbart 
+*                  en epok. Vid exakt minstakvadratlösning genomförs alltid en enda genomgång.
+*                  Vid stokastisk gradientnedstigning avbryts träningen i förtid ifall modellen 
+*                  har konvergerat enligt träningsförlusten. Statistik för samtliga genomgångar 
+*                  returneras.
+*
+*                  - istream    : Inström som träningsdatan skall läsas från.
+*                  - buffer_size: Antalet träningsuppsättningar som buffras (default = 65536).
+**************************************************************************************************/
+load_stats lin_reg::train_streaming(std::istream& istream, 
+                                    const std::size_t buffer_size)
+{
+   load_stats stats;
+   const auto start = std::chrono::steady_clock::now();
+   const auto closed_form = m_solver == solver_mode::closed_form;
+   const auto num_epochs = closed_form ? 1 : m_num_epochs;
+   std::vector<char> block(stream_block_size);
+
+   init_thread_pool();
+   begin_training();
+   m_chunk_in.resize(buffer_size > 0 ? buffer_size : 1);
+   m_chunk_out.resize(m_chunk_in.size());
+
+   for (std::size_t epoch = 0; epoch < num_epochs; ++epoch)
+   {
+      if (epoch > 0)
+      {
+         istream.clear();
+         istream.seekg(0);
+         if (!istream) break;
+      }
+
+      std::size_t num_buffered = 0;
+      std::size_t carry = 0;
+      bool last_block = false;
+      bool discard = false;
+      begin_epoch(epoch);
+
+      while (!last_block)
+      {
+         istream.read(block.data() + carry, static_cast<std::streamsize>(block.size() - carry));
+         const auto num_read = static_cast<std::size_t>(istream.gcount());
+         const auto* end = block.data() + carry + num_read;
+         const auto* i = static_cast<const char*>(block.data());
+         last_block = !istream;
+         stats.num_bytes += num_read;
+
+         if (discard)
+         {
+            const auto* line_end = find_line_end(i, end);
+            discard = line_end == end;
+            i = next_line(line_end, end);
+         }
+
+         while (i < end)
+         {
+            const auto* line_end = find_line_end(i, end);
+            if (line_end == end && !last_block) break;
+            double data[2];
+
+            if (parse_numbers(i, line_end, data, 2, stats.num_failures) == 2)
+            {
+               stats.num_rows++;
+               if (epoch == 0) m_stats.add(data[0], data[1]);
+
+               if (!closed_form)
+               {
+                  m_chunk_in[num_buffered] = data[0];
+                  m_chunk_out[num_buffered] = data[1];
+
+                  if (++num_buffered == m_chunk_in.size())
+                  {
+                     train_chunk(m_chunk_in.data(), m_chunk_out.data(), num_buffered);
+                     num_buffered = 0;
+                  }
+               }
+            }
+            else if (!line_is_blank(i, line_end))
+            {
+               stats.num_skipped++;
+            }
+
+            i = next_line(line_end, end);
+         }
+
+         carry = i < end ? static_cast<std::size_t>(end - i) : 0;
+
+         if (carry == block.size())
+         {
+            stats.num_skipped++;
+            carry = 0;
+            discard = true;
+         }
+         else if (carry > 0)
+         {
+            std::memmove(block.data(), i, carry);
+         }
+      }
+
+      if (num_buffered > 0)
+      {
+         train_chunk(m_chunk_in.data(), m_chunk_out.data(), num_buffered);
+      }
+
+      if (closed_form)
+      {
+         m_epochs_run = 1;
+      }
+      else if (end_epoch())
+      {
+         break;
+      }
+   }
+
+   if (closed_form && m_stats.count() > 0)
+   {
+      m_weights[0] = m_stats.slope();
+      m_bias = m_stats.intercept();
+   }
+
+   stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   m_instrumentation.add_parsed(stats.num_rows, stats.num_skipped, stats.num_failures);
+   return stats;
+}
+
+/**************************************************************************************************
+* train_streaming: Tränar angiven regressionsmodell med träningsdata som läses från filen på 
+*                  angiven filsökväg under träningen, utan att träningsdatan lagras i modellen. 
+*                  Filen läses på nytt inför varje epok. Statistik för samtliga genomgångar 
+*                  returneras.
+*
+*                  - filepath   : Filsökvägen som träningsdatan skall läsas från.
+*                  - buffer_size: Antalet träningsuppsättningar som buffras (default = 65536).
+**************************************************************************************************/
+load_stats lin_reg::train_streaming(const std::string& filepath, 
+                                    const std::size_t buffer_size)
+{
+   std::ifstream fstream(filepath, std::ios::in | std::ios::binary);
+
+   if (!fstream)
+   {
+      std::cerr << "Could not open file at path " << filepath << "!\n\n";
+      return load_stats();
+   }
+   return train_streaming(fstream, buffer_size);
+}
+
+/**************************************************************************************************
+* train_chunk: Tränar angiven regressionsmodell en gång på angivet antal buffrade 
+*              träningsuppsättningar, exempelvis lagrade i vektorerna m_chunk_in samt 
+*              m_chunk_out. Träningsuppsättningarna blandas först om på plats inom bufferten, 
+*              varefter parametrarna justeras per träningsuppsättning eller per minibatch 
+*              beroende på vald batchstorlek. Vid standardisering under den första epoken 
+*              uppdateras först statistiken för insignalerna med buffertens innehåll.
+*
+*              - input   : Buffrade insignaler.
+*              - output  : Buffrade utsignaler.
+*              - num_sets: Antalet buffrade träningsuppsättningar.
+**************************************************************************************************/
+void lin_reg::train_chunk(double* input, 
+                          double* output, 
+                          const std::size_t num_sets)
+{
+   if (m_standardize && m_epochs_run == 0)
+   {
+      update_standardization(input, output, num_sets);
+   }
+
+   const auto shuffle_start = m_instrumentation.now();
+   m_shuffler.shuffle(input, output, num_sets);
+   m_instrumentation.add_time(training_phase::shuffle, shuffle_start);
+
+   if (m_batch_size > 1)
+   {
+      for (std::size_t i = 0; i < num_sets; i += m_batch_size)
+      {
+         const auto last = i + m_batch_size < num_sets ? i + m_batch_size : num_sets;
+         optimize_batch(&input[i], &output[i], last - i, m_weights[0], m_bias);
+      }
+   }
+   else
+   {
+      for (std::size_t i = 0; i < num_sets; ++i)
+      {
+         m_loss_sum += optimize(input[i], output[i], m_weights[0], m_bias);
+      }
+
+      m_loss_count += num_sets;
+   }
+   return;
+}
+
+/**************************************************************************************************
+* train_pipelined: Tränar angiven regressionsmodell med träningsdata från filen på angiven 
+*                  filsökväg, där tolkning av texten och träning sker samtidigt i olika trådar. 
+*                  Filen mappas in i minnet och delas upp i block om ungefär 
+*                  pipeline_block_size byte, som slutar vid radbrytningar. Varje tolkningstråd 
+*                  ansvarar för vart num_parsers:e block och omvandlar texten till buffertar med 
+*                  flyttal, som överförs till tränande tråd via en låsfri ringbuffert per 
+*                  tolkningstråd (spsc_queue). Tomma buffertar återlämnas via en andra 
+*                  ringbuffert, vilket gör att minnesåtgången är fast och att ingen allokering 
+*                  sker under träningen.
+*
+*                  Tränande tråd läser blocken i filens ordning, vilket gör att resultatet är 
+*                  deterministiskt oavsett antalet tolkningstrådar. Därmed närmar sig den totala 
+*                  tiden för inläsning och träning den längsta av tolkningstiden och 
+*                  träningstiden i stället för summan av dessa. Filen tolkas på nytt inför 
+*                  varje epok. Statistik för samtliga genomgångar returneras.
+*
+*                  Ifall modellen konvergerar i förtid signaleras tolkningstrådarna att avsluta 
+*                  via en atomisk flagga, som kontrolleras inför varje block. Varje 
+*                  tolkningstråd avslutar med en tom buffert markerad med stream_end, varefter 
+*                  tränande tråd tömmer ringbuffertarna fram till denna markering. Trådarna 
+*                  hålls av pipeline_threads, som genomför samma avslut ifall ett undantag 
+*                  kastas under träningen.
+*
+*                  - filepath   : Filsökvägen som träningsdatan skall läsas från.
+*                  - chunk_size : Antalet träningsuppsättningar per buffert (default = 65536).
+*                  - num_parsers: Antalet tolkningstrådar (default = 1).
+**************************************************************************************************/
+load_stats lin_reg::train_pipelined(const std::string& filepath, 
+                                    const std::size_t chunk_size,
+                                    const std::size_t num_parsers)
+{
+   load_stats stats;
+   const auto start = std::chrono::steady_clock::now();
+   const mapped_file file(filepath);
+
+   if (!file.is_open())
+   {
+      std::cerr << "Could not open file at path " << filepath << "!\n\n";
+      return stats;
+   }
+
+   const auto* end = file.data() + file.size();
+   std::vector<const char*> blocks{ file.data() };
+
+   while (blocks.back() < end)
+   {
+      const auto* next = blocks.back();
+      next = static_cast<std::size_t>(end - next) > pipeline_block_size ? 
+         next_line(find_line_end(next + pipeline_block_size, end), end) : end;
+      blocks.push_back(next);
+   }
+
+   const auto num_blocks = blocks.size() - 1;
+   const auto closed_form = m_solver == solver_mode::closed_form;
+   const auto num_epochs = closed_form ? 1 : m_num_epochs;
+   const auto parsers = num_parsers > 0 ? num_parsers : 1;
+
+   std::vector<pipeline_chunk> chunks(parsers * pipeline_num_chunks);
+   std::vector<std::unique_ptr<spsc_queue<pipeline_chunk*>>> filled;
+   std::vector<std::unique_ptr<spsc_queue<pipeline_chunk*>>> empty;
+   std::vector<load_stats> parser_stats(parsers);
+   std::atomic<bool> stop{ false };
+
+   for (std::size_t i = 0; i < parsers; ++i)
+   {
+      filled.push_back(std::make_unique<spsc_queue<pipeline_chunk*>>(pipeline_num_chunks));
+      empty.push_back(std::make_unique<spsc_queue<pipeline_chunk*>>(pipeline_num_chunks));
+
+      for (std::size_t j = 0; j < pipeline_num_chunks; ++j)
+      {
+         auto& chunk = chunks[i * pipeline_num_chunks + j];
+         chunk.input.resize(chunk_size > 0 ? chunk_size : 1);
+         chunk.output.resize(chunk.input.size());
+         empty[i]->try_push(&chunk);
+      }
+   }
+
+   auto parse = [&](const std::size_t parser)
+   {
+      auto& parser_stat = parser_stats[parser];
+
+      for (std::size_t epoch = 0; epoch < num_epochs && !stop.load(std::memory_order_relaxed); ++epoch)
+      {
+         for (auto block = parser; block < num_blocks; block += parsers)
+         {
+            if (stop.load(std::memory_order_relaxed)) break;
+            auto* chunk = pop_wait(*empty[parser]);
+            chunk->num_sets = 0;
+
+            for (auto* i = blocks[block]; i < blocks[block + 1];)
+            {
+               const auto* line_end = find_line_end(i, blocks[block + 1]);
+               double data[2];
+
+               if (parse_numbers(i, line_end, data, 2, parser_stat.num_failures) == 2)
+               {
+                  chunk->input[chunk->num_sets] = data[0];
+                  chunk->output[chunk->num_sets] = data[1];
+                  parser_stat.num_rows++;
+
+                  if (++chunk->num_sets == chunk->input.size())
+                  {
+                     chunk->block_end = false;
+                     push_wait(*filled[parser], chunk);
+                     chunk = pop_wait(*empty[parser]);
+                     chunk->num_sets = 0;
+                  }
+               }
+               else if (!line_is_blank(i, line_end))
+               {
+                  parser_stat.num_skipped++;
+               }
+
+               i = next_line(line_end, end);
+            }
+
+            chunk->block_end = true;
+            push_wait(*filled[parser], chunk);
+         }
+      }
+
+      auto* chunk = pop_wait(*empty[parser]);
+      chunk->num_sets = 0;
+      chunk->block_end = true;
+      chunk->stream_end = true;
+      push_wait(*filled[parser], chunk);
+   };
+
+   auto drain = [&](const std::size_t parser)
+   {
+      bool stream_end = false;
+
+      while (!stream_end)
+      {
+         auto* chunk = pop_wait(*filled[parser]);
+         stream_end = chunk->stream_end;
+         push_wait(*empty[parser], chunk);
+      }
+   };
+
+   pipeline_threads threads(stop, drain);
+
+   for (std::size_t i = 0; i < parsers; ++i)
+   {
+      threads.start(parse, i);
+   }
+
+   init_thread_pool();
+   begin_training();
+
+   for (std::size_t epoch = 0; epoch < num_epochs; ++epoch)
+   {
+      begin_epoch(epoch);
+
+      for (std::size_t block = 0; block < num_blocks; ++block)
+      {
+         const auto parser = block % parsers;
+         bool block_end = false;
+
+         while (!block_end)
+         {
+            auto* chunk = pop_wait(*filled[parser]);
+
+            for (std::size_t i = 0; epoch == 0 && i < chunk->num_sets; ++i)
+            {
+               m_stats.add(chunk->input[i], chunk->output[i]);
+            }
+
+            if (!closed_form && chunk->num_sets > 0)
+            {
+               train_chunk(chunk->input.data(), chunk->output.data(), chunk->num_sets);
+            }
+
+            block_end = chunk->block_end;
+            push_wait(*empty[parser], chunk);
+         }
+      }
+
+      if (closed_form)
+      {
+         m_epochs_run = 1;
+      }
+      else if (end_epoch())
+      {
+         break;
+      }
+   }
+
+   threads.join();
+
+   for (auto& i : parser_stats)
+   {
+      stats.num_rows += i.num_rows;
+      stats.num_skipped += i.num_skipped;
+      stats.num_failures += i.num_failures;
+   }
+
+   if (closed_form && m_stats.count() > 0)
+   {
+      m_weights[0] = m_stats.slope();
+      m_bias = m_stats.intercept();
+   }
+
+   stats.num_bytes = file.size() * m_epochs_run;
+   stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   m_instrumentation.add_parsed(stats.num_rows, stats.num_skipped, stats.num_failures);
+   return stats;
+}
+
+/**************************************************************************************************
+* predict: Genomför prediktion med angiven regressionsmodell via angiven insignal och returnerar 
+*          motsvarande predikterad utsignal i form av ett flytta.
+* 
+*          - input: Den insignal som prediktion skall genomföras på.
+**************************************************************************************************/
+double lin_reg::predict(const double input) const
+{
+   return m_weights[0] * input + m_bias;
+}
+
+/**************************************************************************************************
+* predict_all: Genomför prediktion med angiven regressionsmodell för samtliga insignaler som
+*              förekommer i träningsdatan och skriver ut motsvarande predikterade utsignaler via 
+*              angiven utström, där standardutenhet std::cout används som default för utskrift i
+*              i terminalen. Värden mycket nära noll [-threshold, threshold] avrundas till noll
+*              för att undvika utskrift med ett flertal decimaler i onödan, vilket annars sker 
+*              just runt noll.
+*
+*              Prediktionen sker i block via predict_batch och resultatet formateras via 
+*              klassen prediction_writer, som skriver till utströmmen i stora stycken. Utöver 
+*              den läsbara layouten kan prediktionerna skrivas i CSV-format eller binärt format.
+* 
+*              - threshold: Tröskelvärde runt nollpunkten [-threshold, threshold], där
+*                           predikterad värde skall avrundas till noll (default = 0.001).
+*              - ostream  : Angiven utström (default = std::cout).
+*              - format   : Format för utskriften (default = export_format::human).
+**************************************************************************************************/
+void lin_reg::predict_all(const double threshold, 
+                          std::ostream& ostream, 
+                          const export_format format) const
+{
+   prediction_writer writer(ostream, format, threshold);
+   double output[export_block_size];
+   writer.begin();
+
+   for (std::size_t i = 0; i < m_train_in.size(); i += export_block_size)
+   {
+      const auto num_values = m_train_in.size() - i < export_block_size ? 
+         m_train_in.size() - i : export_block_size;
+      predict_batch(&m_train_in[i], output, num_values);
+      writer.write(&m_train_in[i], output, num_values);
+   }
+
+   writer.finish();
+   return;
+}
+
+/**************************************************************************************************
+* predict_range: Genomför prediktion med angiven regressionsmodell för insignaler inom intervallet 
+*                mellan angivet start- och slutvärde [start_val, end_val], där inkrementering av 
+*                insignalen sker inom detta intervall med angivet stegvärde step.
+* 
+*                Varje insignal samt motsvarande predikterat värde skrivs ut via angiven utström,
+*                där standardutenheten std::cout används som default för utskrift i terminalen. 
+*                Värden mycket nära noll [-threshold, threshold] avrundas till noll för att 
+*                undvika utskrift med ett flertal decimaler i onödan, vilket annars sker just 
+*                runt noll.
+*
+*                Insignalerna beräknas utifrån sitt index som start_val + i * step i stället 
+*                för att stegvärdet adderas upprepade gånger, vilket gör att avrundningsfel inte 
+*                ackumuleras över långa intervall. Antalet insignaler avgörs i förväg, där en 
+*                liten tolerans gör att slutvärdet inkluderas trots avrundningsfel i kvoten. 
+*                Prediktionen sker i block via predict_batch och resultatet formateras via 
+*                klassen prediction_writer, se predict_all.
+* 
+*                - start_val: Minvärde för det intervall av insignaler som skall testas.
+*                - end_val  : Maxvärde för det intervall av insignaler som skall testas.
+*                - step     : Stegvärde/inkrementeringsvärde för insignaler (default = 1.0).
+*                - threshold: Tröskelvärde, där samtliga predikterade värden som ligger inom
+*                             intervallet [-threshold, threshold] avrundas till noll för att 
+*                             undvika utskrift med onödigt antal decimaler (default = 0.001).
+*                - ostream:   Angiven utström (default = std::cout).
+*                - format   : Format för utskriften (default = export_format::human).
+**************************************************************************************************/
+void lin_reg::predict_range(const double start_val, 
+                            const double end_val,
+                            const double step, 
+                            const double threshold, 
+                            std::ostream& ostream, 
+                            const export_format format) const
+{
+   prediction_writer writer(ostream, format, threshold);
+   double input[export_block_size], output[export_block_size];
+   std::size_t num_values = 0;
+
+   if (step > 0 && end_val >= start_val)
+   {
+      const auto span = (end_val - start_val) / step;
+      num_values = static_cast<std::size_t>(std::floor(span + 1e-9 * (span > 1 ? span : 1))) + 1;
+   }
+
+   writer.begin();
+
+   for (std::size_t i = 0; i < num_values; i += export_block_size)
+   {
+      const auto block_size = num_values - i < export_block_size ? num_values - i : export_block_size;
+
+      for (std::size_t j = 0; j < block_size; ++j)
+      {
+         input[j] = start_val + static_cast<double>(i + j) * step;
+      }
+
+      predict_batch(input, output, block_size);
+      writer.write(input, output, block_size);
+   }
+
+   writer.finish();
+   return;
+}
+
+/**************************************************************************************************
+* snapshot: Returnerar en ögonblicksbild av angiven regressionsmodell, innehållande modellens 
+*           parametrar samt de hyperparametrar som har angivits för träningen. Parametrarna 
+*           avser alltid insignalernas ursprungliga skala, men standardiseringen samt den 
+*           tillräckliga statistiken för den exakta lösningen lagras också, eftersom dessa 
+*           används när modellen fortsätter tränas via partial_fit.
+**************************************************************************************************/
+model_snapshot lin_reg::snapshot(void) const
+{
+   model_snapshot snapshot;
+   snapshot.weight = m_weights[0];
+   snapshot.bias = m_bias;
+   snapshot.learning_rate = m_learning_rate;
+   snapshot.tolerance = m_tolerance;
+   snapshot.validation_split = m_validation_split;
+   snapshot.beta1 = m_optimizer.beta1();
+   snapshot.beta2 = m_optimizer.beta2();
+   snapshot.gamma = m_optimizer.gamma();
+   snapshot.num_epochs = m_num_epochs;
+   snapshot.epochs_run = m_epochs_run;
+   snapshot.batch_size = m_batch_size;
+   snapshot.patience = m_patience;
+   snapshot.step_size = m_optimizer.step_size();
+   snapshot.solver = static_cast<std::uint32_t>(m_solver);
+   snapshot.optimizer = static_cast<std::uint32_t>(m_optimizer.mode());
+   snapshot.schedule = static_cast<std::uint32_t>(m_optimizer.schedule());
+   snapshot.standardize = m_standardize ? 1 : 0;
+   snapshot.shift = m_shift;
+   snapshot.scale = m_scale;
+   snapshot.input_count = m_input_stats.count();
+   snapshot.input_mean_x = m_input_stats.mean_x();
+   snapshot.input_mean_y = m_input_stats.mean_y();
+   snapshot.input_m2_x = m_input_stats.m2_x();
+   snapshot.input_c_xy = m_input_stats.c_xy();
+   snapshot.stats_count = m_stats.count();
+   snapshot.stats_mean_x = m_stats.mean_x();
+   snapshot.stats_mean_y = m_stats.mean_y();
+   snapshot.stats_m2_x = m_stats.m2_x();
+   snapshot.stats_c_xy = m_stats.c_xy();
+   return snapshot;
+}
+
+/**************************************************************************************************
+* restore: Återställer parametrar samt hyperparametrar för angiven regressionsmodell från 
+*          angiven ögonblicksbild, vilket gör att modellen direkt kan användas för prediktion 
+*          eller för fortsatt träning utan att träningsdatan behöver läsas in. Hyperparametrar 
+*          sätts via respektive set-funktion, vilket gör att ogiltiga värden ignoreras. 
+*          Standardiseringen samt den tillräckliga statistiken för den exakta lösningen 
+*          återställs också, så att partial_fit ger samma resultat som för den ursprungliga 
+*          modellen.
+*
+*          - snapshot: Ögonblicksbilden som modellen skall återställas från.
+**************************************************************************************************/
+void lin_reg::restore(const model_snapshot& snapshot)
+{
+   m_weights[0] = snapshot.weight;
+   m_bias = snapshot.bias;
+   m_epochs_run = static_cast<std::size_t>(snapshot.epochs_run);
+   set_learning_rate(snapshot.learning_rate);
+   set_epochs(static_cast<std::size_t>(snapshot.num_epochs));
+   set_batch_size(static_cast<std::size_t>(snapshot.batch_size));
+   set_early_stopping(snapshot.tolerance, static_cast<std::size_t>(snapshot.patience));
+   set_validation_split(snapshot.validation_split);
+   set_standardization(snapshot.standardize != 0);
+   m_shift = snapshot.shift;
+   m_scale = snapshot.scale;
+   m_input_stats = regression_stats(static_cast<std::size_t>(snapshot.input_count), 
+                                    snapshot.input_mean_x, snapshot.input_mean_y, 
+                                    snapshot.input_m2_x, snapshot.input_c_xy);
+   m_stats = regression_stats(static_cast<std::size_t>(snapshot.stats_count), 
+                              snapshot.stats_mean_x, snapshot.stats_mean_y, 
+                              snapshot.stats_m2_x, snapshot.stats_c_xy);
+
+   if (snapshot.solver <= static_cast<std::uint32_t>(solver_mode::closed_form))
+   {
+      m_solver = static_cast<solver_mode>(snapshot.solver);
+   }
+
+   if (snapshot.optimizer <= static_cast<std::uint32_t>(optimizer_mode::adam))
+   {
+      m_optimizer.set_mode(static_cast<optimizer_mode>(snapshot.optimizer), 
+                           snapshot.beta1, snapshot.beta2);
+   }
+
+   if (snapshot.schedule <= static_cast<std::uint32_t>(schedule_mode::cosine))
+   {
+      m_optimizer.set_schedule(static_cast<schedule_mode>(snapshot.schedule), 
+                               snapshot.gamma, static_cast<std::size_t>(snapshot.step_size));
+   }
+   return;
+}
+
+/**************************************************************************************************
+* save_model: Sparar en ögonblicksbild av angiven regressionsmodell till filen på angiven 
+*             filsökväg, antingen i binärt format (default) eller i textformat. Returnerar true 
+*             ifall modellen kunde sparas.
+*
+*             - filepath: Filsökvägen som modellen skall sparas till.
+*             - format  : Filformat (default = model_format::binary).
+**************************************************************************************************/
+bool lin_reg::save_model(const std::string& filepath, 
+                         const model_format format) const
+{
+   return save_snapshot(snapshot(), filepath, format);
+}
+
+/**************************************************************************************************
+* load_model: Läser in en sparad modell från filen på angiven filsökväg och återställer angiven 
+*             regressionsmodell från denna. Formatet avgörs automatiskt och binära filer 
+*             valideras via kontrollsumma. Modellen lämnas oförändrad ifall filen inte kan 
+*             läsas in, vilket indikeras av returvärdet.
+*
+*             - filepath: Filsökvägen som modellen skall läsas från.
+**************************************************************************************************/
+bool lin_reg::load_model(const std::string& filepath)
+{
+   model_snapshot snapshot;
+   if (!load_snapshot(snapshot, filepath)) return false;
+   restore(snapshot);
+   return true;
+}
+
+/**************************************************************************************************
+* push_wait: Lägger till angiven buffert i angiven ringbuffert. Ifall ringbufferten är full 
+*            lämnar anropande tråd över processorn till andra trådar tills plats finns.
+*
+*            - queue: Den ringbuffert som bufferten skall läggas till i.
+*            - chunk: Den buffert som skall läggas till.
+**************************************************************************************************/
+static void push_wait(spsc_queue<pipeline_chunk*>& queue, 
+                      pipeline_chunk* chunk)
+{
+   while (!queue.try_push(chunk))
+   {
+      std::this_thread::yield();
+   }
+   return;
+}
+
+/**************************************************************************************************
+* pop_wait: Tar bort och returnerar den första bufferten i angiven ringbuffert. Ifall 
+*           ringbufferten är tom lämnar anropande tråd över processorn till andra trådar tills 
+*           en buffert finns tillgänglig.
+*
+*           - queue: Den ringbuffert som bufferten skall hämtas från.
+**************************************************************************************************/
+static pipeline_chunk* pop_wait(spsc_queue<pipeline_chunk*>& queue)
+{
+   pipeline_chunk* chunk;
+
+   while (!queue.try_pop(chunk))
+   {
+      std::this_thread::yield();
+   }
+   return chunk;
+}
+
@@ -1,71 +1,208 @@
-/**************************************************************************************************
-* lin_reg.hpp: Innehller funktionalitet fr implementering av maskininlrningsmodeller som
-*              baseras p linjr regression via klassen lin_reg. 
-**************************************************************************************************/
-#ifndef LIN_REG_HPP_
-#define LIN_REG_HPP_
-
-/* Inkluderingsdirektiv: */
-#include <iostream>
-#include <vector>
-#include <string>
-#include <fstream>
-
-/**************************************************************************************************
-* lin_reg: Klass fr implementering av maskininlrningsmodeller som baseras p linjr regression. 
-*          Trningsdata med valfritt antal trningsuppsttningar kan lsas in frn en fil eller 
-*          passeras via referenser till vektorer.
-* 
-*          Klassens kopieringskonstruktor samt tilldelningsoperator r raderade, vilket medfr att 
-*          minnet fr ett givet objekt ej kan kopieras till/frn ett annat objekt. Klassens
-*          frflyttningskonstruktor r dock implementerad, vilket medfr att minnet fr ett 
-*          givet objekt kan frflyttas till ett annat objekt via funktionen std::move. 
-**************************************************************************************************/
-class lin_reg
-{
-protected:
-   /* Medlemmar: */
-   std::vector<double> m_train_in;          /* Indata fr trningsuppsttningar */
-   std::vector<double> m_train_out;         /* Utdata fr trningsuppsttningarna. */
-   std::vector<std::size_t> m_train_order;  /* Ordningsfljd fr trningsuppsttningarna. */
-   double m_weight = 0;                     /* Lutning (k-vrde). */
-   double m_bias = 0;                       /* Vilovrde (m-vrde). */
-   double m_learning_rate = 0;              /* Lrhastighet (avgr justeringsgrad vid fel). */
-   std::size_t m_num_epochs = 0;            /* Antalet trningsomgngar. */
-
-   /* Medlemsfunktioner: */
-   void extract(const std::string& s);
-   void shuffle(void);
-   void optimize(const double input, 
-                 const double output);
-public:
-   lin_reg(void) { }
-   lin_reg(const std::size_t num_epochs, 
-                     const double learning_rate);
-   ~lin_reg(void) { }
-   lin_reg(lin_reg&) = delete; 
-   lin_reg& operator = (lin_reg&) = delete; 
-   lin_reg(lin_reg&& source) noexcept;
-
-   double weight(void) { return m_weight; }
-   double bias(void) { return m_bias; }
-   double learning_rate(void) { return m_learning_rate; }
-   std::size_t epochs(void) { return m_num_epochs; }
-
-   void set_epochs(const std::size_t num_epochs);
-   void set_learning_rate(const double learning_rate);
-   void load_training_data(const std::string& filepath);
-   void set_training_data(const std::vector<double>& train_in, 
-                          const std::vector<double>& train_out);
-   void train(void);
-   double predict(const double input);
-   void predict_all(const double threshold = 0.001, 
-                    std::ostream& ostream = std::cout);
-   void predict_range(const double start_val, 
-                      const double end_val, 
-                      const double step = 1,
-                      const double threshold = 0.001, 
-                      std::ostream& ostream = std::cout);
-};
-
+/**************************************************************************************************
+* lin_reg.hpp: Innehåller funktionalitet för implementering av maskininlärningsmodeller som
+*              baseras på linjär regression via klassen lin_reg, som härleds från 
+*              instansieringen basic_lin_reg<double, 1> av klassmallen basic_lin_reg.
+**************************************************************************************************/
+#ifndef LIN_REG_HPP_
+#define LIN_REG_HPP_
+
+/* Inkluderingsdirektiv: */
+#include <iostream>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <memory>
+#include <memory_resource>
+
+#include "basic_lin_reg.hpp"
+#include "instrumentation.hpp"
+#include "load_stats.hpp"
+#include "model_snapshot.hpp"
+#include "optimizer.hpp"
+#include "prediction_writer.hpp"
+#include "regression_stats.hpp"
+#include "shuffler.hpp"
+#include "thread_pool.hpp"
+
+/**************************************************************************************************
+* lin_reg: Klass för implementering av maskininlärningsmodeller som baseras på linjär regression. 
+*          Träningsdata med valfritt antal träningsuppsättningar kan läsas in från en fil eller 
+*          passeras via referenser till vektorer.
+*
+*          Klassen härleds från basic_lin_reg<double, 1>, som tillhandahåller träningsdatan, 
+*          inläsningen, randomiseringen, träningslooparna, prediktionen samt statistiken för 
+*          tidsåtgång och genomströmning. Utöver detta stöder lin_reg strömmande, pipelinad 
+*          samt parallell träning, den exakta minstakvadratlösningen, tidigt avbrott, 
+*          validering, adaptiva metoder för justering av parametrarna, scheman för 
+*          lärhastigheten, standardisering, inkrementell träning via partial_fit, träning på 
+*          en delmängd av extern träningsdata via train_indexed samt lagring av modellen. 
+*          Justeringen av parametrarna samt åtgärderna före och efter varje epok passeras 
+*          till träningslooparna i basklassen, vilket gör att looparna inte dupliceras.
+*
+*          Ifall makrot LIN_REG_INSTRUMENTATION definieras vid kompilering samlas statistik 
+*          för tidsåtgång per fas, antalet inlästa, tränade samt predikterade 
+*          träningsuppsättningar och förlusten per epok in, vilken kan läsas via 
+*          training_statistics eller via en återanropsfunktion efter varje epok.
+* 
+*          Vektorerna för träningsdatan allokeras via en minnesresurs (std::pmr), som kan 
+*          anges vid konstruktion, exempelvis en arena eller en resurs som allokerar stora 
+*          sidor. Som default används std::pmr::get_default_resource().
+* 
+*          Klassens kopieringskonstruktor samt tilldelningsoperator är raderade, vilket medför att 
+*          minnet för ett givet objekt ej kan kopieras till/från ett annat objekt. Klassens
+*          förflyttningskonstruktor samt tilldelningsoperator för förflyttning är dock 
+*          implementerade, vilket medför att minnet för ett givet objekt kan förflyttas till ett 
+*          annat objekt via funktionen std::move. 
+**************************************************************************************************/
+class lin_reg : public basic_lin_reg<double, 1>
+{
+public:
+   /* Lösningsmetoder för träning: */
+   enum class solver_mode 
+   { 
+      sgd,        /* Stokastisk gradientnedstigning under angivet antal epoker. */
+      closed_form /* Exakt minstakvadratlösning via en genomgång av träningsdatan. */
+   };
+
+protected:
+   /* Medlemmar: */
+   solver_mode m_solver = solver_mode::sgd; /* Lösningsmetod vid träning. */
+   std::size_t m_num_threads = 1;           /* Antalet trådar vid träning. */
+   std::size_t m_min_shard_size = 0;        /* Angiven gräns per tråd (noll = mäts upp). */
+   std::size_t m_shard_size = 0;            /* Använd gräns per tråd (max = ingen uppdelning). */
+   std::unique_ptr<thread_pool> m_pool;     /* Trådpool för parallell träning. */
+   std::vector<double> m_partial_error;     /* Delsummor av felen per tråd. */
+   std::vector<double> m_partial_error_input; /* Delsummor av felen gånger insignal per tråd. */
+   std::vector<double> m_partial_loss;      /* Delsummor av de kvadrerade felen per tråd. */
+   std::vector<regression_stats> m_partial_stats; /* Statistik per tråd för den exakta lösningen. */
+   std::vector<double> m_chunk_in;          /* Buffrade insignaler vid strömmande träning. */
+   std::vector<double> m_chunk_out;         /* Buffrade utsignaler vid strömmande träning. */
+   double m_tolerance = 0;                  /* Tolerans för konvergens (noll = avstängd). */
+   std::size_t m_patience = 5;              /* Antal epoker utan förbättring innan avbrott. */
+   double m_validation_split = 0;           /* Andel träningsuppsättningar för validering. */
+   std::size_t m_num_validation = 0;        /* Antal träningsuppsättningar för validering. */
+   std::size_t m_split_version = 0;         /* Träningsdatans version vid senaste uppdelningen. */
+   std::size_t m_split_size = 0;            /* Antal valideringsuppsättningar vid uppdelningen. */
+   std::size_t m_epochs_run = 0;            /* Antalet genomförda epoker vid senaste träningen. */
+   std::size_t m_num_stalled = 0;           /* Antal epoker i följd utan förbättring. */
+   double m_best_loss = 0;                  /* Lägsta övervakade förlust hittills. */
+   double m_prev_weight = 0;                /* Vikt vid föregående epoks slut. */
+   double m_prev_bias = 0;                  /* Vilovärde vid föregående epoks slut. */
+   double m_loss_sum = 0;                   /* Summan av de kvadrerade felen för aktuell epok. */
+   std::size_t m_loss_count = 0;            /* Antalet fel som ingår i m_loss_sum. */
+   std::vector<double> m_loss_history;      /* Träningsförlust (medelkvadratfel) per epok. */
+   std::vector<double> m_validation_loss_history; /* Valideringsförlust per epok. */
+   optimizer m_optimizer;                   /* Metod för justering samt schema för lärhastighet. */
+   double m_rate = 0;                       /* Lärhastighet för aktuell epok. */
+   bool m_standardize = false;              /* Indikerar standardisering av insignalerna. */
+   regression_stats m_input_stats;          /* Statistik för standardisering av insignalerna. */
+   double m_shift = 0;                      /* Insignalernas medelvärde vid standardisering. */
+   double m_scale = 1;                      /* Inversen av insignalernas standardavvikelse. */
+   regression_stats m_stats;                /* Tillräcklig statistik för all absorberad data. */
+
+   /* Medlemsfunktioner: */
+   void move_from(lin_reg& source) noexcept;
+   double optimize(const double input, 
+                   const double output,
+                   double& weight,
+                   double& bias);
+   void train_sgd(void);
+   void optimize_batch(const double* input, 
+                       const double* output,
+                       const std::size_t num_sets,
+                       double& weight,
+                       double& bias);
+   void update_parameters(double weight_step, 
+                          double bias_step,
+                          double& weight,
+                          double& bias);
+   void train_closed_form(void);
+   void init_thread_pool(void);
+   void calibrate_shards(void);
+   std::size_t num_shards(const std::size_t num_sets);
+   void train_chunk(double* input, 
+                    double* output, 
+                    const std::size_t num_sets);
+   void begin_training(void);
+   void split_validation(void);
+   double validation_loss(void);
+   void begin_epoch(const std::size_t epoch);
+   bool end_epoch(void);
+   void update_standardization(const double* input, 
+                               const double* output,
+                               const std::size_t num_sets);
+   void refresh_standardization(void);
+public:
+   lin_reg(void) { }
+   explicit lin_reg(std::pmr::memory_resource* resource);
+   lin_reg(const std::size_t num_epochs, 
+           const double learning_rate,
+           std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+   ~lin_reg(void) { }
+   lin_reg(lin_reg&) = delete; 
+   lin_reg& operator = (lin_reg&) = delete; 
+   lin_reg(lin_reg&& source) noexcept;
+   lin_reg& operator = (lin_reg&& source);
+
+   double weight(void) const { return m_weights[0]; }
+   solver_mode solver(void) const { return m_solver; }
+   std::size_t num_threads(void) const { return m_num_threads; }
+   std::size_t min_shard_size(void) const { return m_min_shard_size; }
+   std::size_t shard_size(void) const { return m_shard_size; }
+   double tolerance(void) const { return m_tolerance; }
+   std::size_t patience(void) const { return m_patience; }
+   double validation_split(void) const { return m_validation_split; }
+   std::size_t epochs_run(void) const { return m_epochs_run; }
+   bool standardization(void) const { return m_standardize; }
+   const std::vector<double>& loss_history(void) const { return m_loss_history; }
+   const std::vector<double>& validation_loss_history(void) const { return m_validation_loss_history; }
+
+   void set_solver(const solver_mode solver);
+   void set_num_threads(const std::size_t num_threads);
+   void set_min_shard_size(const std::size_t min_shard_size);
+   void set_early_stopping(const double tolerance, 
+                           const std::size_t patience = 5);
+   void set_validation_split(const double fraction);
+   void set_optimizer(const optimizer_mode mode, 
+                      const double beta1 = 0.9, 
+                      const double beta2 = 0.999);
+   void set_schedule(const schedule_mode schedule, 
+                     const double gamma = 0.1, 
+                     const std::size_t step_size = 10);
+   void set_standardization(const bool standardize);
+   void train(void);
+   void train_indexed(const double* input, 
+                      const double* output, 
+                      std::vector<std::size_t>& order);
+   void partial_fit(const double input, 
+                    const double output);
+   void partial_fit(const double* input, 
+                    const double* output, 
+                    const std::size_t num_sets);
+   void partial_fit(const std::vector<double>& input, 
+                    const std::vector<double>& output);
+   load_stats train_streaming(std::istream& istream, 
+                              const std::size_t buffer_size = 65536);
+   load_stats train_streaming(const std::string& filepath, 
+                              const std::size_t buffer_size = 65536);
+   load_stats train_pipelined(const std::string& filepath, 
+                              const std::size_t chunk_size = 65536,
+                              const std::size_t num_parsers = 1);
+   double predict(const double input) const;
+   void predict_all(const double threshold = 0.001, 
+                    std::ostream& ostream = std::cout, 
+                    const export_format format = export_format::human) const;
+   void predict_range(const double start_val, 
+                      const double end_val, 
+                      const double step = 1,
+                      const double threshold = 0.001, 
+                      std::ostream& ostream = std::cout, 
+                      const export_format format = export_format::human) const;
+   model_snapshot snapshot(void) const;
+   void restore(const model_snapshot& snapshot);
+   bool save_model(const std::string& filepath, 
+                   const model_format format = model_format::binary) const;
+   bool load_model(const std::string& filepath);
+};
+
 #endif /* LIN_REG_HPP_ */
\ No newline at end of file
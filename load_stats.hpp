@@ -0,0 +1,27 @@
+/**************************************************************************************************
+* load_stats.hpp: Innehåller strukturen load_stats, som används för statistik vid inläsning av 
+*                 träningsdata.
+**************************************************************************************************/
+#ifndef LOAD_STATS_HPP_
+#define LOAD_STATS_HPP_
+
+/* Inkluderingsdirektiv: */
+#include <cstddef>
+
+/**************************************************************************************************
+* load_stats: Statistik från inläsning av träningsdata, vilket möjliggör jämförelse mellan olika
+*             inläsningsmetoder avseende antalet rader samt byte som behandlas per sekund.
+**************************************************************************************************/
+struct load_stats
+{
+   std::size_t num_rows = 0;      /* Antalet inlästa träningsuppsättningar. */
+   std::size_t num_skipped = 0;   /* Antalet överhoppade rader (fel antal flyttal). */
+   std::size_t num_failures = 0;  /* Antalet tal som ej kunde typomvandlas. */
+   std::size_t num_bytes = 0;     /* Antalet behandlade byte. */
+   double seconds = 0;            /* Åtgången tid i sekunder. */
+
+   double rows_per_second(void) const { return seconds > 0 ? num_rows / seconds : 0; }
+   double bytes_per_second(void) const { return seconds > 0 ? num_bytes / seconds : 0; }
+};
+
+#endif /* LOAD_STATS_HPP_ */
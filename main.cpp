@@ -1,30 +1,33 @@
-/**************************************************************************************************
-* main.cpp: Implementerar en modell som bygger p linjr regression via ett objekt av klassen
-*           lin_reg. Trningsdata lses in frn en textfil. Efter trningen har
-*           slutfrts s genomfrs prediktion av alla indata inom ett angivet intervall,
-*           vilket skrivs ut i terminalen.
-*
-*           I Windows, kompilera koden och skapa en krbar fil main.exe med fljande kommando:
-*           $ g++ main.cpp lin_reg.cpp -o main.exe -Wall
-*
-*           Kr sedan programmet med fljande kommando:
-*           $ main.exe
-**************************************************************************************************/
-#include "lin_reg.hpp"
-
-/**************************************************************************************************
-* main: Implementerar en maskininlrningsmodell som baseras p linjr regression, dr trningsdata 
-*       lses in frn en fil dpt data.txt. Regressionsmodellen trnas under 1000 epoker med en 
-*       lrhastighet p 1 %. Modellen testas sedan fr indata inom intervallet [-10, 10] med
-*       en stegringshastighet p 0.5. Indata samt motsvarande predikterad utdata skrivs ut i 
-*       terminalen. Resultatet indikerar att modellen efter trning predikterar med en precision
-*       p 100 %, vilket innebr att trningen var lyckad.
-**************************************************************************************************/
-int main(void)
-{
-   lin_reg l1(1000, 0.01);
-   l1.load_training_data("data.txt");
-   l1.train();
-   l1.predict_range(-10, 10, 0.5);
-   return 0;
+/**************************************************************************************************
+* main.cpp: Implementerar en modell som bygger på linjär regression via ett objekt av klassen
+*           lin_reg. Träningsdata läses in från en textfil. Efter att träningen har slutförts
+*           genomförs prediktion av alla indata inom ett angivet intervall, vilket skrivs ut i
+*           terminalen.
+*
+*           I Windows, kompilera koden och skapa en körbar fil main.exe med följande kommando:
+*           $ g++ main.cpp lin_reg.cpp binary_data.cpp mapped_file.cpp text_parser.cpp regression_stats.cpp kernels.cpp thread_pool.cpp shuffler.cpp optimizer.cpp model_snapshot.cpp prediction_writer.cpp -o main.exe -Wall -std=c++17
+*
+*           Kör sedan programmet med följande kommando:
+*           $ main.exe
+**************************************************************************************************/
+#include "lin_reg.hpp"
+
+/**************************************************************************************************
+* main: Implementerar en maskininlärningsmodell som baseras på linjär regression, där träningsdata 
+*       läses in från en fil döpt data.txt. Regressionsmodellen tränas under som mest 1000 epoker 
+*       med en lärhastighet på 1 %, där träningen avbryts i förtid när modellen har konvergerat. 
+*       Antalet genomförda epoker skrivs ut i terminalen. Modellen testas sedan för indata inom 
+*       intervallet [-10, 10] med en stegstorlek på 0.5. Indata samt motsvarande predikterad 
+*       utdata skrivs ut i terminalen. Resultatet indikerar att modellen efter träning 
+*       predikterar med en precision på 100 %, vilket innebär att träningen var lyckad.
+**************************************************************************************************/
+int main(void)
+{
+   lin_reg l1(1000, 0.01);
+   l1.set_early_stopping(1e-8);
+   l1.load_training_data("data.txt");
+   l1.train();
+   std::cout << "Training finished after " << l1.epochs_run() << " epochs!\n\n";
+   l1.predict_range(-10, 10, 0.5);
+   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,162 @@
+/**************************************************************************************************
+* mapped_file.cpp: Innehåller medlemsfunktioner tillhörande klassen mapped_file, vilket används
+*                  för skrivskyddad minnesmappning av filer.
+**************************************************************************************************/
+#include "mapped_file.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**************************************************************************************************
+* mapped_file: Konstruktor för klassen mapped_file, som mappar in filen på angiven filsökväg.
+*              Ifall filen inte kan öppnas förblir objektet stängt, vilket kan kontrolleras
+*              via medlemsfunktionen is_open.
+*
+*              - filepath: Filsökvägen till den fil som skall mappas.
+**************************************************************************************************/
+mapped_file::mapped_file(const std::string& filepath)
+{
+   open(filepath);
+   return;
+}
+
+/**************************************************************************************************
+* ~mapped_file: Destruktor för klassen mapped_file, som tar bort eventuell mappning samt
+*               stänger tillhörande fil.
+**************************************************************************************************/
+mapped_file::~mapped_file(void)
+{
+   close();
+   return;
+}
+
+/**************************************************************************************************
+* mapped_file: Förflyttningskonstruktor, som medför att mappningen ägd av source förflyttas
+*              till angivet objekt this. Efter förflyttningen är source stängd.
+*
+*              - source: Det objekt som mappningen skall förflyttas från.
+**************************************************************************************************/
+mapped_file::mapped_file(mapped_file&& source) noexcept
+{
+   m_data = source.m_data;
+   m_size = source.m_size;
+   m_open = source.m_open;
+#ifdef _WIN32
+   m_file = source.m_file;
+   m_mapping = source.m_mapping;
+   source.m_file = nullptr;
+   source.m_mapping = nullptr;
+#else
+   m_fd = source.m_fd;
+   source.m_fd = -1;
+#endif
+   source.m_data = nullptr;
+   source.m_size = 0;
+   source.m_open = false;
+   return;
+}
+
+/**************************************************************************************************
+* open: Öppnar och mappar in filen på angiven filsökväg. Eventuell tidigare mappning tas först
+*       bort. Vid lyckad mappning returneras true, annars false. En tom fil räknas som lyckad
+*       öppning, men saknar då data att läsa.
+*
+*       Under Linux meddelas operativsystemet att filen kommer läsas sekventiellt, vilket gör
+*       att sidor kan läsas in i förväg och därmed att inläsningen närmar sig diskens bandbredd.
+*
+*       - filepath: Filsökvägen till den fil som skall mappas.
+**************************************************************************************************/
+bool mapped_file::open(const std::string& filepath)
+{
+   close();
+
+#ifdef _WIN32
+   const auto file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                 OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+   if (file == INVALID_HANDLE_VALUE) return false;
+
+   LARGE_INTEGER size;
+   if (!GetFileSizeEx(file, &size))
+   {
+      CloseHandle(file);
+      return false;
+   }
+
+   m_file = file;
+   m_size = static_cast<std::size_t>(size.QuadPart);
+
+   if (m_size > 0)
+   {
+      m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if (!m_mapping)
+      {
+         close();
+         return false;
+      }
+
+      m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+      if (!m_data)
+      {
+         close();
+         return false;
+      }
+   }
+#else
+   m_fd = ::open(filepath.c_str(), O_RDONLY);
+   if (m_fd < 0) return false;
+
+   struct stat info;
+   if (fstat(m_fd, &info) != 0)
+   {
+      close();
+      return false;
+   }
+
+   m_size = static_cast<std::size_t>(info.st_size);
+
+   if (m_size > 0)
+   {
+      auto* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+      if (data == MAP_FAILED)
+      {
+         close();
+         return false;
+      }
+
+      madvise(data, m_size, MADV_SEQUENTIAL);
+      m_data = static_cast<const char*>(data);
+   }
+#endif
+
+   m_open = true;
+   return true;
+}
+
+/**************************************************************************************************
+* close: Tar bort eventuell mappning samt stänger tillhörande fil.
+**************************************************************************************************/
+void mapped_file::close(void)
+{
+#ifdef _WIN32
+   if (m_data) UnmapViewOfFile(m_data);
+   if (m_mapping) CloseHandle(m_mapping);
+   if (m_file) CloseHandle(m_file);
+   m_mapping = nullptr;
+   m_file = nullptr;
+#else
+   if (m_data) munmap(const_cast<char*>(m_data), m_size);
+   if (m_fd >= 0) ::close(m_fd);
+   m_fd = -1;
+#endif
+
+   m_data = nullptr;
+   m_size = 0;
+   m_open = false;
+   return;
+}
@@ -0,0 +1,53 @@
+/**************************************************************************************************
+* mapped_file.hpp: Innehåller funktionalitet för minnesmappning av filer via klassen mapped_file,
+*                  vilket möjliggör att filinnehåll kan läsas direkt ur minnet utan att kopieras
+*                  till mellanliggande buffertar.
+**************************************************************************************************/
+#ifndef MAPPED_FILE_HPP_
+#define MAPPED_FILE_HPP_
+
+/* Inkluderingsdirektiv: */
+#include <string>
+#include <cstddef>
+
+/**************************************************************************************************
+* mapped_file: Klass för skrivskyddad minnesmappning av en fil. Filens innehåll mappas in i
+*              processens adressrymd vid öppning och kan därefter läsas som en sammanhängande
+*              array av tecken. Operativsystemet läser in sidor från disk först när de används,
+*              vilket gör att även mycket stora filer kan läsas utan att allokera heapminne.
+*
+*              Klassens kopieringskonstruktor samt tilldelningsoperator är raderade, eftersom
+*              en given mappning enbart skall ägas av ett objekt. Förflyttningskonstruktorn är
+*              dock implementerad.
+**************************************************************************************************/
+class mapped_file
+{
+protected:
+   /* Medlemmar: */
+   const char* m_data = nullptr; /* Pekare till mappat filinnehåll. */
+   std::size_t m_size = 0;       /* Filens storlek i byte. */
+   bool m_open = false;          /* Indikerar ifall en fil är öppen. */
+#ifdef _WIN32
+   void* m_file = nullptr;       /* Filhandtag (HANDLE). */
+   void* m_mapping = nullptr;    /* Handtag för mappningen (HANDLE). */
+#else
+   int m_fd = -1;                /* Fildeskriptor. */
+#endif
+
+public:
+   mapped_file(void) { }
+   mapped_file(const std::string& filepath);
+   ~mapped_file(void);
+   mapped_file(mapped_file&) = delete;
+   mapped_file& operator = (mapped_file&) = delete;
+   mapped_file(mapped_file&& source) noexcept;
+
+   const char* data(void) const { return m_data; }
+   std::size_t size(void) const { return m_size; }
+   bool is_open(void) const { return m_open; }
+
+   bool open(const std::string& filepath);
+   void close(void);
+};
+
+#endif /* MAPPED_FILE_HPP_ */
@@ -0,0 +1,81 @@
+/**************************************************************************************************
+* model_server.cpp: Innehåller medlemsfunktioner tillhörande klassen model_server, vilket används 
+*                   för prediktion med en regressionsmodell som kan bytas ut under drift.
+**************************************************************************************************/
+#include "model_server.hpp"
+
+/**************************************************************************************************
+* model_server: Skapar en server med en tom modell, där samtliga prediktioner blir noll tills 
+*               en modell har publicerats eller lästs in.
+**************************************************************************************************/
+model_server::model_server(void)
+   : m_snapshot(std::make_shared<const model_snapshot>())
+{
+}
+
+/**************************************************************************************************
+* current: Returnerar en delad pekare till aktuell ögonblicksbild. Ögonblicksbilden hålls vid 
+*          liv så länge pekaren finns kvar, även ifall en ny modell publiceras under tiden, 
+*          vilket gör att flera prediktioner kan genomföras med samma modell.
+**************************************************************************************************/
+std::shared_ptr<const model_snapshot> model_server::current(void) const
+{
+   return std::atomic_load_explicit(&m_snapshot, std::memory_order_acquire);
+}
+
+/**************************************************************************************************
+* publish: Ersätter aktuell modell med en kopia av angiven ögonblicksbild. Trådar som 
+*          genomför prediktion under tiden använder antingen den gamla eller den nya modellen.
+*
+*          - snapshot: Ögonblicksbilden som skall publiceras.
+**************************************************************************************************/
+void model_server::publish(const model_snapshot& snapshot)
+{
+   std::atomic_store_explicit(&m_snapshot, std::make_shared<const model_snapshot>(snapshot), 
+                              std::memory_order_release);
+   m_version.fetch_add(1, std::memory_order_release);
+   return;
+}
+
+/**************************************************************************************************
+* load: Läser in en sparad modell från filen på angiven filsökväg och publicerar denna ifall 
+*       filen är giltig. Aktuell modell lämnas oförändrad ifall filen inte kan läsas in, vilket 
+*       indikeras av returvärdet.
+*
+*       - filepath: Filsökvägen som modellen skall läsas från.
+**************************************************************************************************/
+bool model_server::load(const std::string& filepath)
+{
+   model_snapshot snapshot;
+   if (!load_snapshot(snapshot, filepath)) return false;
+   publish(snapshot);
+   return true;
+}
+
+/**************************************************************************************************
+* predict: Genomför prediktion med aktuell modell via angiven insignal och returnerar 
+*          motsvarande predikterad utsignal.
+*
+*          - input: Den insignal som prediktion skall genomföras på.
+**************************************************************************************************/
+double model_server::predict(const double input) const
+{
+   return current()->predict(input);
+}
+
+/**************************************************************************************************
+* predict_batch: Genomför prediktion med aktuell modell för angivet antal insignaler och skriver 
+*                predikterade utsignaler till arrayen output. Samtliga utsignaler beräknas med 
+*                samma modell, även ifall en ny modell publiceras under tiden.
+*
+*                - input     : Array innehållande de insignaler som prediktion skall genomföras på.
+*                - output    : Array där predikterade utsignaler skall lagras.
+*                - num_values: Antalet insignaler.
+**************************************************************************************************/
+void model_server::predict_batch(const double* input, 
+                                 double* output, 
+                                 const std::size_t num_values) const
+{
+   current()->predict_batch(input, output, num_values);
+   return;
+}
@@ -0,0 +1,52 @@
+/**************************************************************************************************
+* model_server.hpp: Innehåller funktionalitet för prediktion med en sparad regressionsmodell som
+*                   kan bytas ut under drift via klassen model_server.
+**************************************************************************************************/
+#ifndef MODEL_SERVER_HPP_
+#define MODEL_SERVER_HPP_
+
+/* Inkluderingsdirektiv: */
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "model_snapshot.hpp"
+
+/**************************************************************************************************
+* model_server: Klass för prediktion via en oföränderlig ögonblicksbild av en tränad modell, 
+*               som kan ersättas med en ny modell medan andra trådar genomför prediktion. 
+*               Aktuell ögonblicksbild lagras via en delad pekare som läses samt ersätts 
+*               atomärt, vilket gör att en prediktion alltid sker med antingen den gamla eller 
+*               den nya modellen i sin helhet. En ögonblicksbild frigörs först när den sista 
+*               tråden som använder den är klar.
+*
+*               En ny modell läses in samt valideras fullständigt innan den publiceras, vilket 
+*               gör att en skadad fil aldrig ersätter en fungerande modell.
+*
+*               Klassens kopieringskonstruktor samt tilldelningsoperator är raderade.
+**************************************************************************************************/
+class model_server
+{
+protected:
+   /* Medlemmar: */
+   std::shared_ptr<const model_snapshot> m_snapshot;  /* Aktuell ögonblicksbild. */
+   std::atomic<std::size_t> m_version{ 0 };           /* Antalet publicerade modeller. */
+
+public:
+   model_server(void);
+   ~model_server(void) { }
+   model_server(model_server&) = delete;
+   model_server& operator = (model_server&) = delete;
+
+   std::size_t version(void) const { return m_version.load(std::memory_order_acquire); }
+
+   std::shared_ptr<const model_snapshot> current(void) const;
+   void publish(const model_snapshot& snapshot);
+   bool load(const std::string& filepath);
+   double predict(const double input) const;
+   void predict_batch(const double* input, 
+                      double* output, 
+                      const std::size_t num_values) const;
+};
+
+#endif /* MODEL_SERVER_HPP_ */
@@ -0,0 +1,351 @@
+/**************************************************************************************************
+* model_snapshot.cpp: Innehåller funktionalitet för att spara samt läsa in ögonblicksbilder av
+*                     tränade regressionsmodeller i binärt format samt textformat.
+**************************************************************************************************/
+#include "model_snapshot.hpp"
+#include "kernels.hpp"
+
+#include <array>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+/**************************************************************************************************
+* model_header: Huvud för binära modellfiler, som lagras först i filen.
+**************************************************************************************************/
+struct model_header
+{
+   char magic[4] = { 'L', 'R', 'M', 'D' }; /* Identifierar filformatet. */
+   std::uint32_t version = 2;              /* Formatets version. */
+   std::uint32_t size = sizeof(model_snapshot); /* Storleken på ögonblicksbilden i byte. */
+   std::uint32_t checksum = 0;             /* Kontrollsumma (CRC-32) för ögonblicksbilden. */
+};
+
+static_assert(sizeof(model_header) == 16, "model_header must be 16 bytes");
+
+/* Statiska konstanter: */
+static constexpr char text_magic[] = "lin_reg model 2";    /* Första raden i textformatet. */
+static constexpr char text_magic_v1[] = "lin_reg model 1"; /* Första raden i version 1. */
+static constexpr std::size_t snapshot_size_v1 = 120;       /* Storleken på strukten i version 1. */
+
+/**************************************************************************************************
+* crc32_table: Returnerar uppslagstabellen för CRC-32, där varje element utgör kontrollsumman
+*              för motsvarande byte.
+**************************************************************************************************/
+static constexpr std::array<std::uint32_t, 256> crc32_table(void)
+{
+   std::array<std::uint32_t, 256> table{};
+
+   for (std::uint32_t i = 0; i < 256; ++i)
+   {
+      auto crc = i;
+
+      for (int j = 0; j < 8; ++j)
+      {
+         crc = crc & 1 ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+      }
+
+      table[i] = crc;
+   }
+   return table;
+}
+
+/* Statiska funktioner: */
+static bool save_text(const model_snapshot& snapshot,
+                      std::ofstream& fstream);
+static bool load_text(model_snapshot& snapshot,
+                      const char* begin,
+                      const char* end);
+
+/**************************************************************************************************
+* predict_batch: Genomför prediktion för angivet antal insignaler och skriver predikterade
+*                utsignaler till arrayen output, som tillhandahålls av anroparen. Beräkningen
+*                sker via en vektoriserad beräkningskärna.
+*
+*                - input     : Array innehållande insignaler.
+*                - output    : Array där predikterade utsignaler skall lagras.
+*                - num_values: Antalet insignaler som prediktion skall genomföras på.
+**************************************************************************************************/
+void model_snapshot::predict_batch(const double* input,
+                                   double* output,
+                                   const std::size_t num_values) const
+{
+   predict_linear(input, output, num_values, weight, bias);
+   return;
+}
+
+/**************************************************************************************************
+* crc32: Returnerar kontrollsumman CRC-32 (polynomet 0xEDB88320, samma som i zlib) för angivet
+*        antal byte. Uppslagstabellen beräknas vid kompilering.
+*
+*        - data: Pekare till data som kontrollsumman skall beräknas för.
+*        - size: Antalet byte.
+**************************************************************************************************/
+std::uint32_t crc32(const void* data,
+                    const std::size_t size)
+{
+   static constexpr auto table = crc32_table();
+   const auto* bytes = static_cast<const std::uint8_t*>(data);
+   std::uint32_t crc = 0xFFFFFFFF;
+
+   for (std::size_t i = 0; i < size; ++i)
+   {
+      crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+   }
+   return crc ^ 0xFFFFFFFF;
+}
+
+/**************************************************************************************************
+* save_snapshot: Sparar angiven ögonblicksbild till filen på angiven filsökväg i angivet format.
+*                Filen skrivs först till en temporär fil, som därefter döps om till angiven
+*                filsökväg. Därmed ser en process som läser filen samtidigt antingen den gamla
+*                eller den nya modellen, aldrig en halvskriven fil. Returnerar true ifall
+*                filen kunde sparas.
+*
+*                - snapshot: Ögonblicksbilden som skall sparas.
+*                - filepath: Filsökvägen som modellen skall sparas till.
+*                - format  : Filformat (default = model_format::binary).
+**************************************************************************************************/
+bool save_snapshot(const model_snapshot& snapshot,
+                   const std::string& filepath,
+                   const model_format format)
+{
+   const auto temp_path = filepath + ".tmp";
+   std::ofstream fstream(temp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+
+   if (!fstream)
+   {
+      std::cerr << "Could not open file at path " << temp_path << "!\n\n";
+      return false;
+   }
+
+   if (format == model_format::text)
+   {
+      if (!save_text(snapshot, fstream)) return false;
+   }
+   else
+   {
+      model_header header;
+      header.checksum = crc32(&snapshot, sizeof(snapshot));
+      fstream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      fstream.write(reinterpret_cast<const char*>(&snapshot), sizeof(snapshot));
+   }
+
+   fstream.close();
+
+   if (!fstream)
+   {
+      std::remove(temp_path.c_str());
+      std::cerr << "Could not write model to path " << filepath << "!\n\n";
+      return false;
+   }
+
+   if (std::rename(temp_path.c_str(), filepath.c_str()) != 0)
+   {
+      std::remove(filepath.c_str());
+
+      if (std::rename(temp_path.c_str(), filepath.c_str()) != 0)
+      {
+         std::remove(temp_path.c_str());
+         std::cerr << "Could not write model to path " << filepath << "!\n\n";
+         return false;
+      }
+   }
+   return true;
+}
+
+/**************************************************************************************************
+* load_snapshot: Läser in en ögonblicksbild från filen på angiven filsökväg, där formatet avgörs
+*                av filens inledande byte. Binära filer valideras via huvudets version, storlek
+*                samt kontrollsumma, medan textfiler måste inledas med formatets första rad.
+*                Filer av version 1 innehåller enbart strukten fram till och med standardize,
+*                varvid övriga medlemmar behåller sina standardvärden. Angiven ögonblicksbild
+*                uppdateras enbart ifall filen är giltig, vilket indikeras av returvärdet.
+*
+*                - snapshot: Ögonblicksbild som inläst modell skall lagras i.
+*                - filepath: Filsökvägen som modellen skall läsas från.
+**************************************************************************************************/
+bool load_snapshot(model_snapshot& snapshot,
+                   const std::string& filepath)
+{
+   std::ifstream fstream(filepath, std::ios::in | std::ios::binary);
+
+   if (!fstream)
+   {
+      std::cerr << "Could not open file at path " << filepath << "!\n\n";
+      return false;
+   }
+
+   const std::vector<char> data((std::istreambuf_iterator<char>(fstream)),
+                                std::istreambuf_iterator<char>());
+   model_snapshot result;
+   bool valid = false;
+
+   if (data.size() >= sizeof(model_header) && std::memcmp(data.data(), "LRMD", 4) == 0)
+   {
+      model_header header;
+      std::memcpy(&header, data.data(), sizeof(header));
+
+      const auto size = header.version == 1 ? snapshot_size_v1 : sizeof(model_snapshot);
+
+      if ((header.version == 1 || header.version == 2) && header.size == size &&
+          data.size() == sizeof(model_header) + size)
+      {
+         std::memcpy(&result, data.data() + sizeof(header), size);
+         valid = crc32(&result, size) == header.checksum;
+      }
+   }
+   else
+   {
+      valid = load_text(result, data.data(), data.data() + data.size());
+   }
+
+   if (!valid)
+   {
+      std::cerr << "Invalid model at path " << filepath << "!\n\n";
+      return false;
+   }
+
+   snapshot = result;
+   return true;
+}
+
+/**************************************************************************************************
+* save_text: Skriver angiven ögonblicksbild till angiven filström i textformat, med en
+*            parameter per rad på formen namn = värde. Flyttalen formateras via std::to_chars,
+*            vilket ger det kortaste antalet siffror som återger värdet exakt.
+*
+*            - snapshot: Ögonblicksbilden som skall skrivas.
+*            - fstream : Filström som ögonblicksbilden skall skrivas till.
+**************************************************************************************************/
+static bool save_text(const model_snapshot& snapshot,
+                      std::ofstream& fstream)
+{
+   char buffer[64];
+
+   auto write = [&](const char* name, const auto value)
+   {
+      const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+      fstream << name << " = ";
+      fstream.write(buffer, result.ptr - buffer);
+      fstream << "\n";
+   };
+
+   fstream << text_magic << "\n";
+   write("weight", snapshot.weight);
+   write("bias", snapshot.bias);
+   write("learning_rate", snapshot.learning_rate);
+   write("tolerance", snapshot.tolerance);
+   write("validation_split", snapshot.validation_split);
+   write("beta1", snapshot.beta1);
+   write("beta2", snapshot.beta2);
+   write("gamma", snapshot.gamma);
+   write("num_epochs", snapshot.num_epochs);
+   write("epochs_run", snapshot.epochs_run);
+   write("batch_size", snapshot.batch_size);
+   write("patience", snapshot.patience);
+   write("step_size", snapshot.step_size);
+   write("solver", snapshot.solver);
+   write("optimizer", snapshot.optimizer);
+   write("schedule", snapshot.schedule);
+   write("standardize", snapshot.standardize);
+   write("shift", snapshot.shift);
+   write("scale", snapshot.scale);
+   write("input_count", snapshot.input_count);
+   write("input_mean_x", snapshot.input_mean_x);
+   write("input_mean_y", snapshot.input_mean_y);
+   write("input_m2_x", snapshot.input_m2_x);
+   write("input_c_xy", snapshot.input_c_xy);
+   write("stats_count", snapshot.stats_count);
+   write("stats_mean_x", snapshot.stats_mean_x);
+   write("stats_mean_y", snapshot.stats_mean_y);
+   write("stats_m2_x", snapshot.stats_m2_x);
+   write("stats_c_xy", snapshot.stats_c_xy);
+   return static_cast<bool>(fstream);
+}
+
+/**************************************************************************************************
+* load_text: Tolkar en ögonblicksbild i textformat mellan angivna pekare. Tomma rader samt rader
+*            som inleds med # hoppas över och parametrar som saknas behåller sina
+*            standardvärden, vilket gör att även filer av version 1 kan läsas in. Returnerar
+*            false ifall den första raden inte identifierar formatet, ifall ett namn är okänt
+*            eller ifall ett värde inte kan tolkas.
+*
+*            - snapshot: Ögonblicksbild som tolkade parametrar skall lagras i.
+*            - begin   : Pekare till textens första tecken.
+*            - end     : Pekare till adressen direkt efter textens sista tecken.
+**************************************************************************************************/
+static bool load_text(model_snapshot& snapshot,
+                      const char* begin,
+                      const char* end)
+{
+   const auto magic_length = sizeof(text_magic) - 1;
+   if (static_cast<std::size_t>(end - begin) < magic_length) return false;
+   if (std::memcmp(begin, text_magic, magic_length) != 0 &&
+       std::memcmp(begin, text_magic_v1, magic_length) != 0) return false;
+
+   for (auto* i = begin; i < end;)
+   {
+      auto* line_end = static_cast<const char*>(std::memchr(i, '\n', static_cast<std::size_t>(end - i)));
+      if (!line_end) line_end = end;
+      const auto* separator = static_cast<const char*>(std::memchr(i, '=', static_cast<std::size_t>(line_end - i)));
+
+      if (i != begin && separator && *i != '#')
+      {
+         auto* name_end = separator;
+         auto* value = separator + 1;
+         auto* value_end = line_end;
+         while (name_end > i && (name_end[-1] == ' ' || name_end[-1] == '\t')) --name_end;
+         while (value < value_end && (*value == ' ' || *value == '\t')) ++value;
+         while (value_end > value && (value_end[-1] == '\r' || value_end[-1] == ' ')) --value_end;
+
+         const std::string name(i, name_end);
+         bool parsed = false;
+
+         auto read = [&](const char* key, auto& member)
+         {
+            if (parsed || name != key) return;
+            const auto result = std::from_chars(value, value_end, member);
+            parsed = result.ec == std::errc{} && result.ptr == value_end;
+         };
+
+         read("weight", snapshot.weight);
+         read("bias", snapshot.bias);
+         read("learning_rate", snapshot.learning_rate);
+         read("tolerance", snapshot.tolerance);
+         read("validation_split", snapshot.validation_split);
+         read("beta1", snapshot.beta1);
+         read("beta2", snapshot.beta2);
+         read("gamma", snapshot.gamma);
+         read("num_epochs", snapshot.num_epochs);
+         read("epochs_run", snapshot.epochs_run);
+         read("batch_size", snapshot.batch_size);
+         read("patience", snapshot.patience);
+         read("step_size", snapshot.step_size);
+         read("solver", snapshot.solver);
+         read("optimizer", snapshot.optimizer);
+         read("schedule", snapshot.schedule);
+         read("standardize", snapshot.standardize);
+         read("shift", snapshot.shift);
+         read("scale", snapshot.scale);
+         read("input_count", snapshot.input_count);
+         read("input_mean_x", snapshot.input_mean_x);
+         read("input_mean_y", snapshot.input_mean_y);
+         read("input_m2_x", snapshot.input_m2_x);
+         read("input_c_xy", snapshot.input_c_xy);
+         read("stats_count", snapshot.stats_count);
+         read("stats_mean_x", snapshot.stats_mean_x);
+         read("stats_mean_y", snapshot.stats_mean_y);
+         read("stats_m2_x", snapshot.stats_m2_x);
+         read("stats_c_xy", snapshot.stats_c_xy);
+         if (!parsed) return false;
+      }
+
+      i = line_end < end ? line_end + 1 : end;
+   }
+   return true;
+}
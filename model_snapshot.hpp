@@ -0,0 +1,105 @@
+/**************************************************************************************************
+* model_snapshot.hpp: Innehåller funktionalitet för att spara samt läsa in tränade
+*                     regressionsmodeller via strukten model_snapshot, antingen i ett kompakt
+*                     binärt format med kontrollsumma eller i ett läsbart textformat.
+*
+*                     Det binära formatet består av ett huvud om 16 byte följt av strukten
+*                     model_snapshot i sin helhet. Huvudet innehåller en kontrollsumma (CRC-32)
+*                     för strukten, vilket gör att skadade eller trunkerade filer upptäcks vid
+*                     inläsning. Samtliga tal lagras med little-endian byteordning.
+*
+*                     Textformatet består av en rad per parameter på formen namn = värde, där
+*                     flyttalen skrivs med det kortaste antalet siffror som återger värdet
+*                     exakt vid inläsning.
+*
+*                     Version 2 av formaten lägger till statistiken för standardiseringen samt
+*                     den tillräckliga statistiken för den exakta lösningen sist i strukten.
+*                     Filer av version 1 kan fortfarande läsas in, där den tillagda statistiken
+*                     då behåller sina standardvärden.
+**************************************************************************************************/
+#ifndef MODEL_SNAPSHOT_HPP_
+#define MODEL_SNAPSHOT_HPP_
+
+/* Inkluderingsdirektiv: */
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/* Filformat för sparade modeller: */
+enum class model_format
+{
+   binary, /* Kompakt binärt format med kontrollsumma. */
+   text    /* Läsbart textformat med en parameter per rad. */
+};
+
+/**************************************************************************************************
+* model_snapshot: Ögonblicksbild av en tränad regressionsmodell, bestående av modellens
+*                 parametrar samt de hyperparametrar som användes vid träningen. Uppräkningar
+*                 lagras som heltal med samma värden som motsvarande enum class, så att
+*                 strukten har en fast layout utan utfyllnad och kan skrivas direkt till fil.
+*
+*                 Utöver parametrarna lagras insignalernas medelvärde samt inversen av
+*                 standardavvikelsen vid standardisering, tillsammans med statistiken som dessa
+*                 beräknades från, samt den tillräckliga statistiken för den exakta lösningen.
+*                 Därmed kan en återställd modell fortsätta tränas via partial_fit med samma
+*                 resultat som modellen som ögonblicksbilden skapades från.
+*
+*                 En ögonblicksbild ändras inte efter att den har skapats, vilket gör att flera
+*                 trådar kan genomföra prediktion via samma ögonblicksbild samtidigt.
+**************************************************************************************************/
+struct model_snapshot
+{
+   double weight = 0;                /* Lutning (k-värde). */
+   double bias = 0;                  /* Vilovärde (m-värde). */
+   double learning_rate = 0;         /* Lärhastighet. */
+   double tolerance = 0;             /* Tolerans för tidigt avbrott. */
+   double validation_split = 0;      /* Andel träningsuppsättningar för validering. */
+   double beta1 = 0.9;               /* Avtagandefaktor för första momentet. */
+   double beta2 = 0.999;             /* Avtagandefaktor för andra momentet. */
+   double gamma = 0.1;               /* Multiplikator för lärhastighetens schema. */
+   std::uint64_t num_epochs = 0;     /* Antalet träningsomgångar. */
+   std::uint64_t epochs_run = 0;     /* Antalet genomförda epoker vid träningen. */
+   std::uint64_t batch_size = 1;     /* Antalet träningsuppsättningar per minibatch. */
+   std::uint64_t patience = 5;       /* Antal epoker utan förbättring innan avbrott. */
+   std::uint64_t step_size = 10;     /* Antalet epoker per steg vid stegvis schema. */
+   std::uint32_t solver = 0;         /* Lösningsmetod (lin_reg::solver_mode). */
+   std::uint32_t optimizer = 0;      /* Metod för justering (optimizer_mode). */
+   std::uint32_t schedule = 0;       /* Schema för lärhastigheten (schedule_mode). */
+   std::uint32_t standardize = 0;    /* Indikerar standardisering av insignalerna. */
+   double shift = 0;                 /* Insignalernas medelvärde vid standardisering. */
+   double scale = 1;                 /* Inversen av insignalernas standardavvikelse. */
+   std::uint64_t input_count = 0;    /* Antalet träningsuppsättningar i input-statistiken. */
+   double input_mean_x = 0;          /* Medelvärde för insignalerna vid standardisering. */
+   double input_mean_y = 0;          /* Medelvärde för utsignalerna vid standardisering. */
+   double input_m2_x = 0;            /* Kvadratsumma för insignalerna vid standardisering. */
+   double input_c_xy = 0;            /* Produktsumma för in- och utsignal vid standardisering. */
+   std::uint64_t stats_count = 0;    /* Antalet träningsuppsättningar för den exakta lösningen. */
+   double stats_mean_x = 0;          /* Medelvärde för insignalerna för den exakta lösningen. */
+   double stats_mean_y = 0;          /* Medelvärde för utsignalerna för den exakta lösningen. */
+   double stats_m2_x = 0;            /* Kvadratsumma för insignalerna för den exakta lösningen. */
+   double stats_c_xy = 0;            /* Produktsumma för in- och utsignal för den exakta lösningen. */
+
+   /**********************************************************************************************
+   * predict: Genomför prediktion via angiven insignal och returnerar predikterad utsignal.
+   *
+   *          - input: Insignal som prediktion skall genomföras med.
+   **********************************************************************************************/
+   double predict(const double input) const { return weight * input + bias; }
+
+   void predict_batch(const double* input,
+                      double* output,
+                      const std::size_t num_values) const;
+};
+
+static_assert(sizeof(model_snapshot) == 216, "model_snapshot must not contain padding");
+
+/* Funktionsdeklarationer: */
+std::uint32_t crc32(const void* data,
+                    const std::size_t size);
+bool save_snapshot(const model_snapshot& snapshot,
+                   const std::string& filepath,
+                   const model_format format = model_format::binary);
+bool load_snapshot(model_snapshot& snapshot,
+                   const std::string& filepath);
+
+#endif /* MODEL_SNAPSHOT_HPP_ */
@@ -0,0 +1,26 @@
+/**************************************************************************************************
+* multi_lin_reg.hpp: Innehåller aliaset multi_lin_reg för implementering av 
+*                    maskininlärningsmodeller som baseras på linjär regression med valfritt 
+*                    antal insignaler.
+**************************************************************************************************/
+#ifndef MULTI_LIN_REG_HPP_
+#define MULTI_LIN_REG_HPP_
+
+/* Inkluderingsdirektiv: */
+#include "basic_lin_reg.hpp"
+#include "feature_matrix.hpp"
+
+/**************************************************************************************************
+* multi_lin_reg: Alias för regressionsmodeller med flyttal av dubbel precision och valfritt 
+*                antal insignaler per träningsuppsättning, där antalet avgörs vid körning. 
+*                Modellen består av en vikt per insignal samt ett gemensamt vilovärde, där 
+*                prediktion genomförs som skalärprodukten av insignalerna och vikterna plus 
+*                vilovärdet.
+*
+*                Layout anger lagringsordningen för matrisen med träningsdatans insignaler, 
+*                radvis som default. Se basic_lin_reg för övrig funktionalitet.
+**************************************************************************************************/
+template <matrix_layout Layout = matrix_layout::row_major>
+using multi_lin_reg = basic_lin_reg<double, dynamic_features, Layout>;
+
+#endif /* MULTI_LIN_REG_HPP_ */
@@ -0,0 +1,152 @@
+/**************************************************************************************************
+* optimizer.cpp: Innehåller medlemsfunktioner tillhörande klassen optimizer, vilket används för
+*                justering av parametrar samt schemaläggning av lärhastigheten vid träning.
+**************************************************************************************************/
+#include "optimizer.hpp"
+
+#include <cmath>
+
+/* Statiska konstanter: */
+static constexpr double pi = 3.14159265358979323846;
+
+/**************************************************************************************************
+* set_mode: Väljer metod för justering av parametrarna samt avtagandefaktorer för första och
+*           andra momentet, ifall angivna faktorer ligger inom intervallet [0, 1). Faktorn beta1
+*           används vid momentum, Nesterov samt Adam, medan beta2 används vid RMSProp samt Adam.
+*           Tillståndet för adaptiva metoder nollställs.
+*
+*           - mode : Metod för justering.
+*           - beta1: Avtagandefaktor för första momentet (default = 0.9).
+*           - beta2: Avtagandefaktor för andra momentet (default = 0.999).
+**************************************************************************************************/
+void optimizer::set_mode(const optimizer_mode mode,
+                         const double beta1,
+                         const double beta2)
+{
+   m_mode = mode;
+   if (beta1 >= 0 && beta1 < 1) m_beta1 = beta1;
+   if (beta2 >= 0 && beta2 < 1) m_beta2 = beta2;
+   reset();
+   return;
+}
+
+/**************************************************************************************************
+* set_schedule: Väljer schema för lärhastigheten. Vid stegvis schema multipliceras
+*               lärhastigheten med gamma var step_size:e epok, medan lärhastigheten vid
+*               exponentiellt schema multipliceras med gamma efter varje epok. Vid
+*               cosinusschema avtar lärhastigheten mjukt mot noll under angivet antal epoker.
+*
+*               - schedule : Schema för lärhastigheten.
+*               - gamma    : Multiplikator vid stegvis samt exponentiellt schema (default = 0.1).
+*               - step_size: Antalet epoker per steg vid stegvis schema (default = 10).
+**************************************************************************************************/
+void optimizer::set_schedule(const schedule_mode schedule,
+                             const double gamma,
+                             const std::size_t step_size)
+{
+   m_schedule = schedule;
+   if (gamma > 0) m_gamma = gamma;
+   if (step_size > 0) m_step_size = step_size;
+   return;
+}
+
+/**************************************************************************************************
+* reset: Nollställer tillståndet för adaptiva metoder inför en ny träning.
+**************************************************************************************************/
+void optimizer::reset(void)
+{
+   m_first[0] = m_first[1] = 0;
+   m_second[0] = m_second[1] = 0;
+   m_beta1_power = 1;
+   m_beta2_power = 1;
+   return;
+}
+
+/**************************************************************************************************
+* rate: Returnerar lärhastigheten för angiven epok enligt valt schema.
+*
+*       - learning_rate: Lärhastigheten vid träningens början.
+*       - epoch        : Index för aktuell epok, där den första epoken har index 0.
+*       - num_epochs   : Det totala antalet epoker, vilket används vid cosinusschema.
+**************************************************************************************************/
+double optimizer::rate(const double learning_rate,
+                       const std::size_t epoch,
+                       const std::size_t num_epochs) const
+{
+   switch (m_schedule)
+   {
+      case schedule_mode::step:
+         return learning_rate * std::pow(m_gamma, static_cast<double>(epoch / m_step_size));
+      case schedule_mode::exponential:
+         return learning_rate * std::pow(m_gamma, static_cast<double>(epoch));
+      case schedule_mode::cosine:
+         return num_epochs > 0 ?
+            0.5 * learning_rate * (1 + std::cos(pi * epoch / num_epochs)) : learning_rate;
+      default:
+         return learning_rate;
+   }
+}
+
+/**************************************************************************************************
+* update: Omvandlar angivna nedstigningsriktningar för vikten respektive vilovärdet till de steg
+*         som parametrarna skall justeras med enligt vald metod, där resultatet lagras på plats.
+*         Vid Nesterov används den omformulerade varianten där parametrarna justeras med
+*         hastigheten efter uppdateringen plus aktuellt gradientsteg, vilket motsvarar att
+*         gradienten utvärderas vid den förutsagda positionen. Vid Adam korrigeras momenten för
+*         att de initieras till noll.
+*
+*         - weight_step  : Nedstigningsriktning för vikten, som ersätts med viktens steg.
+*         - bias_step    : Nedstigningsriktning för vilovärdet, som ersätts med vilovärdets steg.
+*         - learning_rate: Lärhastighet för aktuell epok.
+**************************************************************************************************/
+void optimizer::update(double& weight_step,
+                       double& bias_step,
+                       const double learning_rate)
+{
+   double* steps[2] = { &weight_step, &bias_step };
+
+   if (m_mode == optimizer_mode::adam)
+   {
+      m_beta1_power *= m_beta1;
+      m_beta2_power *= m_beta2;
+   }
+
+   for (std::size_t i = 0; i < 2; ++i)
+   {
+      auto& step = *steps[i];
+      const auto gradient = step;
+
+      switch (m_mode)
+      {
+         case optimizer_mode::momentum:
+            m_first[i] = m_beta1 * m_first[i] + learning_rate * gradient;
+            step = m_first[i];
+            break;
+         case optimizer_mode::nesterov:
+            m_first[i] = m_beta1 * m_first[i] + learning_rate * gradient;
+            step = m_beta1 * m_first[i] + learning_rate * gradient;
+            break;
+         case optimizer_mode::adagrad:
+            m_second[i] += gradient * gradient;
+            step = learning_rate * gradient / (std::sqrt(m_second[i]) + m_epsilon);
+            break;
+         case optimizer_mode::rmsprop:
+            m_second[i] = m_beta2 * m_second[i] + (1 - m_beta2) * gradient * gradient;
+            step = learning_rate * gradient / (std::sqrt(m_second[i]) + m_epsilon);
+            break;
+         case optimizer_mode::adam:
+         {
+            m_first[i] = m_beta1 * m_first[i] + (1 - m_beta1) * gradient;
+            m_second[i] = m_beta2 * m_second[i] + (1 - m_beta2) * gradient * gradient;
+            const auto first = m_first[i] / (1 - m_beta1_power);
+            const auto second = m_second[i] / (1 - m_beta2_power);
+            step = learning_rate * first / (std::sqrt(second) + m_epsilon);
+            break;
+         }
+         default:
+            step = learning_rate * gradient;
+            break;
+      }
+   }
+   return;
+}
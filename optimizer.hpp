@@ -0,0 +1,83 @@
+/**************************************************************************************************
+* optimizer.hpp: Innehåller funktionalitet för justering av parametrar samt schemaläggning av
+*                lärhastigheten vid träning av regressionsmodeller via klassen optimizer.
+**************************************************************************************************/
+#ifndef OPTIMIZER_HPP_
+#define OPTIMIZER_HPP_
+
+/* Inkluderingsdirektiv: */
+#include <cstddef>
+
+/* Metoder för justering av parametrarna: */
+enum class optimizer_mode
+{
+   sgd,      /* Justering med lärhastigheten multiplicerat med gradienten. */
+   momentum, /* Gradienterna ackumuleras med avtagande vikt (tung boll). */
+   nesterov, /* Som momentum, men gradienten utvärderas i förväg (Nesterov). */
+   adagrad,  /* Lärhastigheten skalas per parameter med summan av kvadrerade gradienter. */
+   rmsprop,  /* Som adagrad, men med ett exponentiellt glidande medelvärde. */
+   adam      /* Glidande medelvärden av gradienterna samt deras kvadrater med biaskorrigering. */
+};
+
+/* Scheman för lärhastigheten: */
+enum class schedule_mode
+{
+   constant,    /* Lärhastigheten är konstant under hela träningen. */
+   step,        /* Lärhastigheten multipliceras med gamma var step_size:e epok. */
+   exponential, /* Lärhastigheten multipliceras med gamma efter varje epok. */
+   cosine       /* Lärhastigheten avtar enligt en halv cosinusperiod mot noll. */
+};
+
+/**************************************************************************************************
+* optimizer: Klass för justering av en regressionsmodells parametrar utifrån gradienterna.
+*            Gradienterna passeras i form av nedstigningsriktningar (negativa gradienter), vilket
+*            motsvarar felet respektive felet multiplicerat med insignalen, och omvandlas på
+*            plats till de steg som parametrarna skall justeras med. Tillståndet för adaptiva
+*            metoder lagras per parameter, där index 0 avser vikten och index 1 vilovärdet.
+*
+*            Lärhastigheten för en given epok beräknas via medlemsfunktionen rate utifrån valt
+*            schema, vilket gör att schemat enbart behöver utvärderas en gång per epok.
+**************************************************************************************************/
+class optimizer
+{
+protected:
+   /* Medlemmar: */
+   optimizer_mode m_mode = optimizer_mode::sgd;      /* Metod för justering. */
+   schedule_mode m_schedule = schedule_mode::constant; /* Schema för lärhastigheten. */
+   double m_beta1 = 0.9;                             /* Avtagandefaktor för första momentet. */
+   double m_beta2 = 0.999;                           /* Avtagandefaktor för andra momentet. */
+   double m_epsilon = 1e-8;                          /* Förhindrar division med noll. */
+   double m_gamma = 0.1;                             /* Multiplikator vid stegvis/exponentiellt schema. */
+   std::size_t m_step_size = 10;                     /* Antalet epoker per steg vid stegvis schema. */
+   double m_first[2] = { 0, 0 };                     /* Första momentet per parameter. */
+   double m_second[2] = { 0, 0 };                    /* Andra momentet per parameter. */
+   double m_beta1_power = 1;                         /* beta1 upphöjt till antalet steg. */
+   double m_beta2_power = 1;                         /* beta2 upphöjt till antalet steg. */
+
+public:
+   optimizer(void) { }
+   ~optimizer(void) { }
+
+   optimizer_mode mode(void) const { return m_mode; }
+   schedule_mode schedule(void) const { return m_schedule; }
+   double beta1(void) const { return m_beta1; }
+   double beta2(void) const { return m_beta2; }
+   double gamma(void) const { return m_gamma; }
+   std::size_t step_size(void) const { return m_step_size; }
+
+   void set_mode(const optimizer_mode mode,
+                 const double beta1 = 0.9,
+                 const double beta2 = 0.999);
+   void set_schedule(const schedule_mode schedule,
+                     const double gamma = 0.1,
+                     const std::size_t step_size = 10);
+   void reset(void);
+   double rate(const double learning_rate,
+               const std::size_t epoch,
+               const std::size_t num_epochs) const;
+   void update(double& weight_step,
+               double& bias_step,
+               const double learning_rate);
+};
+
+#endif /* OPTIMIZER_HPP_ */
@@ -0,0 +1,174 @@
+/**************************************************************************************************
+* prediction_writer.cpp: Innehåller medlemsfunktioner tillhörande klassen prediction_writer,
+*                        vilket används för snabb utskrift av prediktioner.
+**************************************************************************************************/
+#include "prediction_writer.hpp"
+
+#include <cstring>
+
+/* Statiska konstanter: */
+static constexpr std::size_t max_row_size = 256; /* Största antal byte per prediktion. */
+static constexpr char frame[] = 
+   "----------------------------------------------------------------------------\n";
+
+/**************************************************************************************************
+* prediction_writer: Konstruktor, som förbereder utskrift till angiven utström i angivet format.
+*                    Antalet värdesiffror samt notation för flyttal hämtas från utströmmen.
+*
+*                    - ostream    : Utström som prediktionerna skall skrivas till.
+*                    - format     : Format för utskriften.
+*                    - threshold  : Tröskelvärde, där predikterade värden inom intervallet 
+*                                   [-threshold, threshold] skrivs ut som noll i textformat.
+*                    - buffer_size: Buffertens storlek i byte (default = 1 MiB).
+**************************************************************************************************/
+prediction_writer::prediction_writer(std::ostream& ostream, 
+                                     const export_format format, 
+                                     const double threshold, 
+                                     const std::size_t buffer_size)
+   : m_ostream(ostream), 
+     m_format(format), 
+     m_threshold(threshold), 
+     m_notation(std::chars_format::general), 
+     m_precision(static_cast<int>(ostream.precision())), 
+     m_buffer(buffer_size > 2 * max_row_size ? buffer_size : 2 * max_row_size)
+{
+   const auto floatfield = ostream.flags() & std::ios::floatfield;
+
+   if (floatfield == std::ios::fixed)
+   {
+      m_notation = std::chars_format::fixed;
+   }
+   else if (floatfield == std::ios::scientific)
+   {
+      m_notation = std::chars_format::scientific;
+   }
+}
+
+/**************************************************************************************************
+* begin: Inleder utskriften med en ram i läsbart format respektive en rubrikrad i CSV-format. 
+*        I binärt format skrivs ingenting.
+**************************************************************************************************/
+void prediction_writer::begin(void)
+{
+   if (m_format == export_format::human)
+   {
+      append(frame, sizeof(frame) - 1);
+   }
+   else if (m_format == export_format::csv)
+   {
+      append("input,output\n", 13);
+   }
+   return;
+}
+
+/**************************************************************************************************
+* write: Skriver angivet antal par av insignaler och predikterade utsignaler till bufferten, 
+*        som skrivs till utströmmen varje gång den blir full. I textformat skrivs predikterade 
+*        värden inom intervallet [-threshold, threshold] som noll.
+*
+*        - input     : Array innehållande insignaler.
+*        - output    : Array innehållande motsvarande predikterade utsignaler.
+*        - num_values: Antalet prediktioner.
+**************************************************************************************************/
+void prediction_writer::write(const double* input, 
+                              const double* output, 
+                              const std::size_t num_values)
+{
+   for (std::size_t i = 0; i < num_values; ++i)
+   {
+      if (m_size + max_row_size > m_buffer.size()) flush();
+      const auto prediction = output[i] > -m_threshold && output[i] < m_threshold ? 0.0 : output[i];
+
+      if (m_format == export_format::binary)
+      {
+         const double pair[2] = { input[i], output[i] };
+         append(reinterpret_cast<const char*>(pair), sizeof(pair));
+      }
+      else if (m_format == export_format::csv)
+      {
+         append_number(input[i]);
+         m_buffer[m_size++] = ',';
+         append_number(prediction);
+         m_buffer[m_size++] = '\n';
+      }
+      else
+      {
+         if (m_num_written + i > 0) m_buffer[m_size++] = '\n';
+         append("Input: ", 7);
+         append_number(input[i]);
+         append("\nOutput: ", 9);
+         append_number(prediction);
+         m_buffer[m_size++] = '\n';
+      }
+   }
+
+   m_num_written += num_values;
+   return;
+}
+
+/**************************************************************************************************
+* finish: Avslutar utskriften med en ram i läsbart format och skriver därefter återstående 
+*         innehåll i bufferten till utströmmen.
+**************************************************************************************************/
+void prediction_writer::finish(void)
+{
+   if (m_format == export_format::human)
+   {
+      append(frame, sizeof(frame) - 1);
+      append("\n", 1);
+   }
+
+   flush();
+   return;
+}
+
+/**************************************************************************************************
+* flush: Skriver buffertens innehåll till utströmmen i ett stycke och tömmer bufferten.
+**************************************************************************************************/
+void prediction_writer::flush(void)
+{
+   if (m_size > 0)
+   {
+      m_ostream.write(m_buffer.data(), static_cast<std::streamsize>(m_size));
+      m_size = 0;
+   }
+   return;
+}
+
+/**************************************************************************************************
+* append: Lägger till angivet antal byte i bufferten, som först töms ifall platsen inte räcker.
+*
+*         - data: Pekare till de byte som skall läggas till.
+*         - size: Antalet byte.
+**************************************************************************************************/
+void prediction_writer::append(const char* data, 
+                               const std::size_t size)
+{
+   if (m_size + size > m_buffer.size()) flush();
+   std::memcpy(m_buffer.data() + m_size, data, size);
+   m_size += size;
+   return;
+}
+
+/**************************************************************************************************
+* append_number: Formaterar angivet flyttal direkt i bufferten via std::to_chars med utströmmens 
+*                antal värdesiffror samt notation. Ifall talet inte får plats, vilket enbart 
+*                kan ske vid ett mycket stort antal decimaler i fast notation, används den 
+*                kortaste representation som återger talet exakt.
+*
+*                - value: Flyttalet som skall formateras.
+**************************************************************************************************/
+void prediction_writer::append_number(const double value)
+{
+   auto* first = m_buffer.data() + m_size;
+   auto* last = first + max_row_size / 4;
+   auto result = std::to_chars(first, last, value, m_notation, m_precision);
+
+   if (result.ec != std::errc{})
+   {
+      result = std::to_chars(first, last, value);
+   }
+
+   m_size = static_cast<std::size_t>(result.ptr - m_buffer.data());
+   return;
+}
@@ -0,0 +1,72 @@
+/**************************************************************************************************
+* prediction_writer.hpp: Innehåller funktionalitet för snabb utskrift av insignaler samt
+*                        predikterade utsignaler via klassen prediction_writer.
+**************************************************************************************************/
+#ifndef PREDICTION_WRITER_HPP_
+#define PREDICTION_WRITER_HPP_
+
+/* Inkluderingsdirektiv: */
+#include <charconv>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+/* Format för utskrift av prediktioner: */
+enum class export_format
+{
+   human, /* Läsbar layout med en rad för insignal och en rad för utsignal. */
+   csv,   /* Kommaseparerade värden med en rubrikrad, en prediktion per rad. */
+   binary /* Flyttal av dubbel precision, där insignal och utsignal lagras parvis. */
+};
+
+/**************************************************************************************************
+* prediction_writer: Klass för utskrift av par av insignaler och predikterade utsignaler till en
+*                    utström. Talen formateras via std::to_chars direkt i en stor buffert, som
+*                    skrivs till utströmmen i ett stycke när den är full, i stället för att
+*                    varje tal och textsnutt skrivs via operatorn <<. Antalet värdesiffror samt
+*                    notation (fast, vetenskaplig eller allmän) hämtas från utströmmen, vilket
+*                    gör att resultatet i läsbart format blir identiskt med utskrift via <<.
+*
+*                    Utskriften inleds via begin, varefter prediktioner skrivs via write i
+*                    valfritt antal anrop. Utskriften avslutas via finish, som även tömmer
+*                    bufferten.
+*
+*                    Klassens kopieringskonstruktor samt tilldelningsoperator är raderade.
+**************************************************************************************************/
+class prediction_writer
+{
+protected:
+   /* Medlemmar: */
+   std::ostream& m_ostream;                  /* Utström som prediktionerna skrivs till. */
+   export_format m_format;                   /* Format för utskriften. */
+   double m_threshold;                       /* Tröskelvärde för avrundning till noll. */
+   std::chars_format m_notation;             /* Notation för flyttal enligt utströmmen. */
+   int m_precision;                          /* Antalet värdesiffror enligt utströmmen. */
+   std::vector<char> m_buffer;               /* Buffert för formaterad text. */
+   std::size_t m_size = 0;                   /* Antalet använda byte i bufferten. */
+   std::size_t m_num_written = 0;            /* Antalet skrivna prediktioner. */
+
+   /* Medlemsfunktioner: */
+   void flush(void);
+   void append(const char* data, 
+               const std::size_t size);
+   void append_number(const double value);
+public:
+   prediction_writer(std::ostream& ostream, 
+                     const export_format format, 
+                     const double threshold, 
+                     const std::size_t buffer_size = 1 << 20);
+   ~prediction_writer(void) { }
+   prediction_writer(prediction_writer&) = delete;
+   prediction_writer& operator = (prediction_writer&) = delete;
+
+   std::size_t num_written(void) const { return m_num_written; }
+
+   void begin(void);
+   void write(const double* input, 
+              const double* output, 
+              const std::size_t num_values);
+   void finish(void);
+};
+
+#endif /* PREDICTION_WRITER_HPP_ */
@@ -0,0 +1,90 @@
+/**************************************************************************************************
+* regression_stats.cpp: Innehåller medlemsfunktioner tillhörande klassen regression_stats, vilket
+*                       används för beräkning av den exakta minstakvadratlösningen för linjär
+*                       regression med en insignal.
+**************************************************************************************************/
+#include "regression_stats.hpp"
+
+/**************************************************************************************************
+* add: Lägger till en träningsuppsättning i statistiken. Medelvärden samt centrerade
+*      kvadratsummor uppdateras enligt Welfords metod, vilket ger numeriskt stabila resultat
+*      även för miljontals träningsuppsättningar med stora värden.
+*
+*      - x: Insignal för träningsuppsättningen.
+*      - y: Utsignal för träningsuppsättningen.
+**************************************************************************************************/
+void regression_stats::add(const double x, 
+                           const double y)
+{
+   m_count++;
+   const auto dx = x - m_mean_x;
+   m_mean_x += dx / m_count;
+   m_mean_y += (y - m_mean_y) / m_count;
+   m_m2_x += dx * (x - m_mean_x);
+   m_c_xy += dx * (y - m_mean_y);
+   return;
+}
+
+/**************************************************************************************************
+* merge: Slår ihop angiven statistik med statistiken för angivet objekt this, så att resultatet
+*        motsvarar statistik för samtliga träningsuppsättningar i båda objekten.
+*
+*        - other: Den statistik som skall slås ihop med angivet objekt.
+**************************************************************************************************/
+void regression_stats::merge(const regression_stats& other)
+{
+   if (other.m_count == 0) return;
+
+   if (m_count == 0)
+   {
+      *this = other;
+      return;
+   }
+
+   const auto count = m_count + other.m_count;
+   const auto dx = other.m_mean_x - m_mean_x;
+   const auto dy = other.m_mean_y - m_mean_y;
+   const auto weight = static_cast<double>(m_count) * other.m_count / count;
+
+   m_mean_x += dx * other.m_count / count;
+   m_mean_y += dy * other.m_count / count;
+   m_m2_x += other.m_m2_x + dx * dx * weight;
+   m_c_xy += other.m_c_xy + dx * dy * weight;
+   m_count = count;
+   return;
+}
+
+/**************************************************************************************************
+* clear: Nollställer ackumulerad statistik.
+**************************************************************************************************/
+void regression_stats::clear(void)
+{
+   *this = regression_stats();
+   return;
+}
+
+/**************************************************************************************************
+* slope: Returnerar lutningen (k-värdet) för minstakvadratlösningen. Ifall samtliga insignaler
+*        är lika saknas en unik lösning, vilket medför att lutningen sätts till noll.
+**************************************************************************************************/
+double regression_stats::slope(void) const
+{
+   return m_m2_x > 0 ? m_c_xy / m_m2_x : 0;
+}
+
+/**************************************************************************************************
+* intercept: Returnerar vilovärdet (m-värdet) för minstakvadratlösningen.
+**************************************************************************************************/
+double regression_stats::intercept(void) const
+{
+   return m_mean_y - slope() * m_mean_x;
+}
+
+/**************************************************************************************************
+* variance_x: Returnerar variansen för insignalerna, beräknad över samtliga ackumulerade 
+*             träningsuppsättningar. Ifall statistik saknas returneras noll.
+**************************************************************************************************/
+double regression_stats::variance_x(void) const
+{
+   return m_count > 0 ? m_m2_x / m_count : 0;
+}
@@ -0,0 +1,57 @@
+/**************************************************************************************************
+* regression_stats.hpp: Innehåller funktionalitet för numeriskt stabil beräkning av den exakta
+*                       minstakvadratlösningen för linjär regression via klassen
+*                       regression_stats.
+**************************************************************************************************/
+#ifndef REGRESSION_STATS_HPP_
+#define REGRESSION_STATS_HPP_
+
+/* Inkluderingsdirektiv: */
+#include <cstddef>
+
+/**************************************************************************************************
+* regression_stats: Klass för ackumulering av tillräcklig statistik för linjär regression med en
+*                   insignal. I stället för att summera x, y, xy samt x² direkt, vilket leder
+*                   till kancellation vid stora datamängder, uppdateras medelvärden samt centrerade
+*                   kvadratsummor löpande enligt Welfords metod. Två objekt kan även slås ihop,
+*                   vilket möjliggör att statistik kan beräknas för delar av datan var för sig.
+*
+*                   Lutning samt vilovärde för minstakvadratlösningen kan därefter läsas ut via
+*                   medlemsfunktionerna slope samt intercept.
+**************************************************************************************************/
+class regression_stats
+{
+protected:
+   /* Medlemmar: */
+   std::size_t m_count = 0; /* Antalet ackumulerade träningsuppsättningar. */
+   double m_mean_x = 0;     /* Medelvärde för insignalerna. */
+   double m_mean_y = 0;     /* Medelvärde för utsignalerna. */
+   double m_m2_x = 0;       /* Summan av kvadrerade avvikelser från insignalernas medelvärde. */
+   double m_c_xy = 0;       /* Summan av produkterna av avvikelserna för in- och utsignal. */
+
+public:
+   regression_stats(void) { }
+   regression_stats(const std::size_t count, 
+                    const double mean_x, 
+                    const double mean_y, 
+                    const double m2_x, 
+                    const double c_xy)
+      : m_count(count), m_mean_x(mean_x), m_mean_y(mean_y), m_m2_x(m2_x), m_c_xy(c_xy) { }
+   ~regression_stats(void) { }
+
+   std::size_t count(void) const { return m_count; }
+   double mean_x(void) const { return m_mean_x; }
+   double mean_y(void) const { return m_mean_y; }
+   double m2_x(void) const { return m_m2_x; }
+   double c_xy(void) const { return m_c_xy; }
+
+   void add(const double x, 
+            const double y);
+   void merge(const regression_stats& other);
+   void clear(void);
+   double slope(void) const;
+   double intercept(void) const;
+   double variance_x(void) const;
+};
+
+#endif /* REGRESSION_STATS_HPP_ */
@@ -0,0 +1,113 @@
+/**************************************************************************************************
+* shuffle_check.cpp: Kontrollerar att klassen shuffler enbart flyttar befintliga index, så att
+*                    en delmängd av träningsuppsättningarna, exempelvis träningsvecken vid
+*                    korsvalidering, innehåller samma index efter randomiseringen. Kontrollen
+*                    genomförs för samtliga metoder för randomisering och upprepas ett antal
+*                    gånger, likt en randomisering per epok. Vid blockvis randomisering
+*                    kontrolleras även att varje block innehåller samma index som tidigare.
+*
+*                    I Windows, kompilera koden och skapa en körbar fil shuffle_check.exe med
+*                    följande kommando:
+*                    $ g++ shuffle_check.cpp shuffler.cpp -o shuffle_check.exe -Wall -std=c++17
+*
+*                    Kör sedan programmet med följande kommando:
+*                    $ shuffle_check.exe
+**************************************************************************************************/
+#include "shuffler.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+/**************************************************************************************************
+* same_indexes: Indikerar ifall två vektorer innehåller samma uppsättning index, oberoende av
+*               ordningsföljden.
+*
+*               - a: Den första vektorn.
+*               - b: Den andra vektorn.
+**************************************************************************************************/
+static bool same_indexes(std::vector<std::size_t> a,
+                         std::vector<std::size_t> b)
+{
+   std::sort(a.begin(), a.end());
+   std::sort(b.begin(), b.end());
+   return a == b;
+}
+
+/**************************************************************************************************
+* same_blocks: Indikerar ifall varje fullständigt block om block_size positioner i order
+*              innehåller samma index som något av blocken i reference, vilket gäller vid
+*              blockvis randomisering.
+*
+*              - order     : Randomiserad ordningsföljd.
+*              - reference : Ordningsföljd innan randomiseringen.
+*              - block_size: Antalet index per block.
+**************************************************************************************************/
+static bool same_blocks(const std::vector<std::size_t>& order,
+                        const std::vector<std::size_t>& reference,
+                        const std::size_t block_size)
+{
+   const auto num_blocks = order.size() / block_size;
+
+   for (std::size_t i = 0; i < num_blocks; ++i)
+   {
+      const auto first = order.begin() + static_cast<std::ptrdiff_t>(i * block_size);
+      const std::vector<std::size_t> block(first, first + static_cast<std::ptrdiff_t>(block_size));
+      auto found = false;
+
+      for (std::size_t j = 0; j < num_blocks && !found; ++j)
+      {
+         const auto source = reference.begin() + static_cast<std::ptrdiff_t>(j * block_size);
+         found = same_indexes(block, { source, source + static_cast<std::ptrdiff_t>(block_size) });
+      }
+
+      if (!found) return false;
+   }
+   return true;
+}
+
+/**************************************************************************************************
+* main: Randomiserar en delmängd bestående av vart tredje index i omvänd ordning via samtliga
+*       metoder och kontrollerar att samma index finns kvar efter varje randomisering. Ifall
+*       samtliga kontroller lyckas returneras 0, annars 1.
+**************************************************************************************************/
+int main(void)
+{
+   const std::size_t block_size = 64;
+   const std::size_t num_epochs = 5;
+   std::vector<std::size_t> subset;
+
+   for (std::size_t i = 3000; i > 0; i -= 3)
+   {
+      subset.push_back(i * 7);
+   }
+
+   auto num_errors = 0;
+
+   for (const auto mode : { shuffle_mode::none, shuffle_mode::full, shuffle_mode::block })
+   {
+      shuffler shuffler;
+      shuffler.set_mode(mode, block_size);
+      auto order = subset;
+
+      for (std::size_t epoch = 0; epoch < num_epochs; ++epoch)
+      {
+         const auto previous = order;
+         shuffler.shuffle(order);
+
+         if (!same_indexes(order, subset))
+         {
+            std::cerr << "Shuffle mode " << static_cast<int>(mode)
+                      << " changed the index set in epoch " << epoch << "!\n";
+            num_errors++;
+         }
+         else if (mode == shuffle_mode::block && !same_blocks(order, previous, block_size))
+         {
+            std::cerr << "Block shuffle mixed indexes across blocks in epoch " << epoch << "!\n";
+            num_errors++;
+         }
+      }
+   }
+
+   std::cout << (num_errors == 0 ? "All shuffle checks passed!\n" : "Shuffle checks failed!\n");
+   return num_errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,238 @@
+/**************************************************************************************************
+* shuffler.cpp: Innehåller medlemsfunktioner tillhörande klassen shuffler, vilket används för 
+*               reproducerbar randomisering av ordningsföljden för träningsuppsättningar.
+**************************************************************************************************/
+#include "shuffler.hpp"
+
+#include <algorithm>
+#include <utility>
+
+/* Statiska funktioner: */
+static inline std::uint64_t rotate_left(const std::uint64_t x, 
+                                        const int k);
+static inline std::uint64_t multiply_high(const std::uint64_t x, 
+                                          const std::uint64_t y, 
+                                          std::uint64_t& low);
+
+/**************************************************************************************************
+* shuffler: Konstruktor för klassen shuffler, som initierar slumptalsgeneratorn med angivet frö.
+*
+*           - seed: Frö för slumptalsgeneratorn (default = default_seed).
+**************************************************************************************************/
+shuffler::shuffler(const std::uint64_t seed)
+{
+   this->seed(seed);
+   return;
+}
+
+/**************************************************************************************************
+* seed: Initierar slumptalsgeneratorns tillstånd utifrån angivet frö via splitmix64, vilket 
+*       garanterar ett giltigt tillstånd (ej enbart nollor) för samtliga frön.
+*
+*       - seed: Frö för slumptalsgeneratorn.
+**************************************************************************************************/
+void shuffler::seed(const std::uint64_t seed)
+{
+   auto x = seed;
+
+   for (auto& i : m_state)
+   {
+      auto z = (x += 0x9e3779b97f4a7c15ULL);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      i = z ^ (z >> 31);
+   }
+   return;
+}
+
+/**************************************************************************************************
+* set_mode: Väljer metod för randomisering samt blockstorlek vid blockvis randomisering.
+*
+*           - mode      : Metod för randomisering.
+*           - block_size: Antalet index per block vid blockvis metod (default = 4096).
+**************************************************************************************************/
+void shuffler::set_mode(const shuffle_mode mode, 
+                        const std::size_t block_size)
+{
+   m_mode = mode;
+   if (block_size > 0) m_block_size = block_size;
+   return;
+}
+
+/**************************************************************************************************
+* next: Returnerar nästa slumptal om 64 bitar från slumptalsgeneratorn xoshiro256**.
+**************************************************************************************************/
+std::uint64_t shuffler::next(void)
+{
+   const auto result = rotate_left(m_state[1] * 5, 7) * 9;
+   const auto t = m_state[1] << 17;
+
+   m_state[2] ^= m_state[0];
+   m_state[3] ^= m_state[1];
+   m_state[1] ^= m_state[2];
+   m_state[0] ^= m_state[3];
+   m_state[2] ^= t;
+   m_state[3] = rotate_left(m_state[3], 45);
+   return result;
+}
+
+/**************************************************************************************************
+* bounded: Returnerar ett likformigt fördelat slumptal i intervallet [0, range) via Lemires 
+*          metod, där ett slumptal om 64 bitar multipliceras med range och de övre 64 bitarna 
+*          av produkten utgör resultatet. Slumptal som skulle ge en snedfördelning förkastas, 
+*          vilket sker ytterst sällan.
+*
+*          - range: Antalet möjliga värden, måste överstiga noll.
+**************************************************************************************************/
+std::size_t shuffler::bounded(const std::size_t range)
+{
+   const auto n = static_cast<std::uint64_t>(range);
+   std::uint64_t low;
+   auto high = multiply_high(next(), n, low);
+
+   if (low < n)
+   {
+      const auto threshold = (0 - n) % n;
+
+      while (low < threshold)
+      {
+         high = multiply_high(next(), n, low);
+      }
+   }
+   return static_cast<std::size_t>(high);
+}
+
+/**************************************************************************************************
+* shuffle: Randomiserar ordningsföljden för angivna index enligt vald metod. Vid fullständig 
+*          randomisering blandas indexen om på plats via Fisher-Yates. Vid blockvis 
+*          randomisering delas positionerna i vektorn in i block om m_block_size positioner, 
+*          där blocken placeras i slumpmässig ordning via bufferten m_buffer och indexen inom 
+*          varje block därefter blandas om. Ett avslutande ofullständigt block behåller sin 
+*          plats sist, vilket gör att blockgränserna är desamma vid varje anrop.
+*
+*          Indexen flyttas enbart mellan positioner och skrivs aldrig över, vilket gör att 
+*          vektorn alltid innehåller samma uppsättning index efter randomiseringen. Därmed 
+*          fungerar samtliga metoder även för en delmängd av träningsuppsättningarna, 
+*          exempelvis träningsvecken vid korsvalidering.
+*
+*          - order: Vektor innehållande de index vars ordningsföljd skall randomiseras.
+**************************************************************************************************/
+void shuffler::shuffle(std::vector<std::size_t>& order)
+{
+   if (m_mode == shuffle_mode::full)
+   {
+      for (auto i = order.size(); i > 1; --i)
+      {
+         std::swap(order[i - 1], order[bounded(i)]);
+      }
+   }
+   else if (m_mode == shuffle_mode::block)
+   {
+      const auto num_blocks = order.size() / m_block_size;
+      m_blocks.resize(num_blocks);
+      m_buffer.resize(order.size());
+
+      for (std::size_t i = 0; i < num_blocks; ++i)
+      {
+         m_blocks[i] = i;
+      }
+
+      for (auto i = num_blocks; i > 1; --i)
+      {
+         std::swap(m_blocks[i - 1], m_blocks[bounded(i)]);
+      }
+
+      for (std::size_t i = 0; i < num_blocks; ++i)
+      {
+         const auto* source = order.data() + m_blocks[i] * m_block_size;
+         std::copy(source, source + m_block_size, m_buffer.data() + i * m_block_size);
+      }
+
+      const auto tail = num_blocks * m_block_size;
+      std::copy(order.data() + tail, order.data() + order.size(), m_buffer.data() + tail);
+      order.swap(m_buffer);
+
+      for (std::size_t first = 0; first < order.size(); first += m_block_size)
+      {
+         const auto size = order.size() - first < m_block_size ? order.size() - first : m_block_size;
+
+         for (auto i = size; i > 1; --i)
+         {
+            std::swap(order[first + i - 1], order[first + bounded(i)]);
+         }
+      }
+   }
+   return;
+}
+
+/**************************************************************************************************
+* shuffle: Blandar om två arrayer med angivet antal element på plats via Fisher-Yates, där 
+*          element med samma index i båda arrayerna flyttas tillsammans, exempelvis in- och 
+*          utsignaler för buffrade träningsuppsättningar. Ifall ingen randomisering har valts 
+*          lämnas arrayerna oförändrade.
+*
+*          - first       : Den första arrayen.
+*          - second      : Den andra arrayen.
+*          - num_elements: Antalet element i respektive array.
+**************************************************************************************************/
+void shuffler::shuffle(double* first, 
+                       double* second, 
+                       const std::size_t num_elements)
+{
+   if (m_mode == shuffle_mode::none) return;
+
+   for (auto i = num_elements; i > 1; --i)
+   {
+      const auto r = bounded(i);
+      std::swap(first[i - 1], first[r]);
+      std::swap(second[i - 1], second[r]);
+   }
+   return;
+}
+
+/**************************************************************************************************
+* rotate_left: Roterar bitarna i angivet tal angivet antal steg åt vänster.
+*
+*              - x: Det tal som skall roteras.
+*              - k: Antalet steg.
+**************************************************************************************************/
+static inline std::uint64_t rotate_left(const std::uint64_t x, 
+                                        const int k)
+{
+   return (x << k) | (x >> (64 - k));
+}
+
+/**************************************************************************************************
+* multiply_high: Multiplicerar två tal om 64 bitar och returnerar de övre 64 bitarna av den 
+*                128-bitars produkten, medan de nedre 64 bitarna lagras via referensen low. 
+*                Ifall kompilatorn stödjer heltal om 128 bitar används dessa, annars delas 
+*                talen upp i halvor om 32 bitar, vilket fungerar även med MSVC samt på 
+*                32-bitars plattformar.
+*
+*                - x  : Den första faktorn.
+*                - y  : Den andra faktorn.
+*                - low: Referens till variabeln som produktens nedre 64 bitar skall lagras i.
+**************************************************************************************************/
+static inline std::uint64_t multiply_high(const std::uint64_t x, 
+                                          const std::uint64_t y, 
+                                          std::uint64_t& low)
+{
+#if defined(__SIZEOF_INT128__)
+   const auto product = static_cast<unsigned __int128>(x) * y;
+   low = static_cast<std::uint64_t>(product);
+   return static_cast<std::uint64_t>(product >> 64);
+#else
+   const auto x_low = x & 0xffffffffULL;
+   const auto x_high = x >> 32;
+   const auto y_low = y & 0xffffffffULL;
+   const auto y_high = y >> 32;
+
+   const auto low_low = x_low * y_low;
+   const auto high_low = x_high * y_low;
+   const auto low_high = x_low * y_high;
+   const auto middle = (low_low >> 32) + (high_low & 0xffffffffULL) + low_high;
+
+   low = (middle << 32) | (low_low & 0xffffffffULL);
+   return x_high * y_high + (high_low >> 32) + (middle >> 32);
+#endif
+}
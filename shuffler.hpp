@@ -0,0 +1,65 @@
+/**************************************************************************************************
+* shuffler.hpp: Innehåller funktionalitet för reproducerbar randomisering av ordningsföljden för 
+*               träningsuppsättningar via klassen shuffler.
+**************************************************************************************************/
+#ifndef SHUFFLER_HPP_
+#define SHUFFLER_HPP_
+
+/* Inkluderingsdirektiv: */
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/* Metoder för randomisering av ordningsföljden: */
+enum class shuffle_mode
+{
+   none,  /* Ordningsföljden lämnas oförändrad. */
+   full,  /* Samtliga index blandas om via Fisher-Yates. */
+   block  /* Blocken blandas om, följt av indexen inom varje block. */
+};
+
+/**************************************************************************************************
+* shuffler: Klass för randomisering av ordningsföljden för träningsuppsättningar. Varje objekt 
+*           har ett eget tillstånd för slumptalsgeneratorn xoshiro256**, vilket gör att 
+*           resultatet är reproducerbart för ett givet frö och att olika modeller kan tränas i 
+*           olika trådar utan att dela tillstånd. Slumpmässiga index inom ett intervall dras 
+*           via Lemires metod, som till skillnad från rand() % n saknar snedfördelning och 
+*           inte kräver någon division i normalfallet.
+*
+*           Vid blockvis randomisering (shuffle_mode::block) delas positionerna i angiven 
+*           vektor in i block om m_block_size index. Blockens ordningsföljd blandas om, varefter 
+*           indexen inom varje block blandas om, vilket enbart flyttar befintliga index. 
+*           Träningsdatan läses därmed i stort sett sekventiellt, vilket utnyttjar cacheminnet 
+*           betydligt bättre än fullständig omblandning vid stora datamängder.
+**************************************************************************************************/
+class shuffler
+{
+protected:
+   /* Medlemmar: */
+   std::uint64_t m_state[4];                 /* Slumptalsgeneratorns tillstånd. */
+   shuffle_mode m_mode = shuffle_mode::full; /* Metod för randomisering. */
+   std::size_t m_block_size = 4096;          /* Antalet index per block vid blockvis metod. */
+   std::vector<std::size_t> m_blocks;        /* Blockens ordningsföljd vid blockvis metod. */
+   std::vector<std::size_t> m_buffer;        /* Buffert för omplacering av block. */
+
+public:
+   static constexpr std::uint64_t default_seed = 0x853c49e6748fea9bULL;
+
+   shuffler(const std::uint64_t seed = default_seed);
+   ~shuffler(void) { }
+
+   shuffle_mode mode(void) const { return m_mode; }
+   std::size_t block_size(void) const { return m_block_size; }
+
+   void seed(const std::uint64_t seed);
+   void set_mode(const shuffle_mode mode, 
+                 const std::size_t block_size = 4096);
+   std::uint64_t next(void);
+   std::size_t bounded(const std::size_t range);
+   void shuffle(std::vector<std::size_t>& order);
+   void shuffle(double* first, 
+                double* second, 
+                const std::size_t num_elements);
+};
+
+#endif /* SHUFFLER_HPP_ */
@@ -0,0 +1,80 @@
+/**************************************************************************************************
+* solver_check.cpp: Kontrollerar att lösningsmetoderna för klassen lin_reg ger samma modell för
+*                   träningsdatan i data.txt. En modell tränas via stokastisk
+*                   gradientnedstigning under 1000 epoker med en lärhastighet på 1 %, medan en
+*                   annan modell tränas via den exakta minstakvadratlösningen
+*                   (solver_mode::closed_form). Vikten samt vilovärdet för modellerna måste
+*                   överensstämma inom angiven tolerans, vilket även kontrolleras mot den kända
+*                   lösningen y = -2.5x + 10. Därefter byts lösningsmetoden för den första
+*                   modellen till den exakta lösningen, varefter en ny träningsuppsättning
+*                   absorberas av båda modellerna via partial_fit, vilket måste ge samma modell.
+*
+*                   I Windows, kompilera koden och skapa en körbar fil solver_check.exe med
+*                   följande kommando:
+*                   $ g++ solver_check.cpp lin_reg.cpp binary_data.cpp mapped_file.cpp text_parser.cpp regression_stats.cpp kernels.cpp thread_pool.cpp shuffler.cpp optimizer.cpp model_snapshot.cpp prediction_writer.cpp -o solver_check.exe -Wall -std=c++17
+*
+*                   Kör sedan programmet med följande kommando:
+*                   $ solver_check.exe
+**************************************************************************************************/
+#include "lin_reg.hpp"
+
+#include <cmath>
+
+/**************************************************************************************************
+* agrees: Indikerar ifall angivna värden överensstämmer inom angiven tolerans. Ifall så inte är
+*         fallet skrivs värdena ut i terminalen.
+*
+*         - name     : Namnet på den parameter som jämförs.
+*         - actual   : Det erhållna värdet.
+*         - expected : Det förväntade värdet.
+*         - tolerance: Största tillåtna absoluta avvikelse.
+**************************************************************************************************/
+static bool agrees(const char* name,
+                   const double actual,
+                   const double expected,
+                   const double tolerance)
+{
+   if (std::abs(actual - expected) <= tolerance) return true;
+   std::cerr << name << " differs: " << actual << " != " << expected << "!\n";
+   return false;
+}
+
+/**************************************************************************************************
+* main: Tränar en modell via respektive lösningsmetod på data.txt och jämför vikten samt
+*       vilovärdet mellan modellerna samt mot den kända lösningen. Därefter jämförs modellerna
+*       efter att en ny träningsuppsättning har absorberats via den exakta lösningen. Ifall
+*       samtliga kontroller lyckas returneras 0, annars 1.
+**************************************************************************************************/
+int main(void)
+{
+   const double tolerance = 1e-6;
+   lin_reg sgd(1000, 0.01);
+   lin_reg closed_form;
+
+   sgd.set_seed(1);
+   closed_form.set_solver(lin_reg::solver_mode::closed_form);
+
+   if (sgd.load_training_data("data.txt").num_rows == 0 ||
+       closed_form.load_training_data("data.txt").num_rows == 0)
+   {
+      std::cerr << "No training data found in data.txt!\n";
+      return 1;
+   }
+
+   sgd.train();
+   closed_form.train();
+
+   auto ok = agrees("Weight", sgd.weight(), closed_form.weight(), tolerance);
+   ok = agrees("Bias", sgd.bias(), closed_form.bias(), tolerance) && ok;
+   ok = agrees("Closed-form weight", closed_form.weight(), -2.5, tolerance) && ok;
+   ok = agrees("Closed-form bias", closed_form.bias(), 10, tolerance) && ok;
+
+   sgd.set_solver(lin_reg::solver_mode::closed_form);
+   sgd.partial_fit(20, -40);
+   closed_form.partial_fit(20, -40);
+   ok = agrees("Partial-fit weight", sgd.weight(), closed_form.weight(), tolerance) && ok;
+   ok = agrees("Partial-fit bias", sgd.bias(), closed_form.bias(), tolerance) && ok;
+
+   std::cout << (ok ? "Both solvers agree on data.txt!\n" : "Solver check failed!\n");
+   return ok ? 0 : 1;
+}
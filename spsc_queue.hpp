@@ -0,0 +1,84 @@
+/**************************************************************************************************
+* spsc_queue.hpp: Innehåller klassmallen spsc_queue, en låsfri ringbuffert för överföring av 
+*                 element från exakt en producerande tråd till exakt en konsumerande tråd.
+**************************************************************************************************/
+#ifndef SPSC_QUEUE_HPP_
+#define SPSC_QUEUE_HPP_
+
+/* Inkluderingsdirektiv: */
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/**************************************************************************************************
+* spsc_queue: Låsfri kö i form av en ringbuffert med fast kapacitet, avsedd för en producent och 
+*             en konsument (single producer, single consumer). Producenten skriver enbart till 
+*             m_tail och konsumenten enbart till m_head, vilket gör att inga atomära 
+*             läs-modifiera-skriv-operationer eller lås behövs. Index placeras på separata 
+*             cachelines för att undvika att trådarna stör varandra (false sharing).
+*
+*             Kapaciteten avrundas uppåt till närmaste tvåpotens, så att index kan beräknas via 
+*             bitmaskning i stället för division.
+**************************************************************************************************/
+template <typename T>
+class spsc_queue
+{
+protected:
+   /* Medlemmar: */
+   std::vector<T> m_buffer;                      /* Ringbuffertens element. */
+   std::size_t m_mask = 0;                       /* Bitmask för beräkning av index. */
+   alignas(64) std::atomic<std::size_t> m_head{ 0 }; /* Index för nästa element att läsa. */
+   alignas(64) std::atomic<std::size_t> m_tail{ 0 }; /* Index för nästa lediga plats. */
+
+public:
+   /**********************************************************************************************
+   * spsc_queue: Konstruktor, som skapar en tom kö med plats för minst angivet antal element.
+   *
+   *             - capacity: Minsta antal element som kön skall kunna lagra.
+   **********************************************************************************************/
+   spsc_queue(const std::size_t capacity)
+   {
+      std::size_t size = 2;
+      while (size < capacity) size *= 2;
+      m_buffer.resize(size);
+      m_mask = size - 1;
+      return;
+   }
+
+   ~spsc_queue(void) { }
+   spsc_queue(spsc_queue&) = delete;
+   spsc_queue& operator = (spsc_queue&) = delete;
+
+   /**********************************************************************************************
+   * try_push: Lägger till angivet element sist i kön ifall det finns plats och returnerar true, 
+   *           annars returneras false. Får enbart anropas av producenten.
+   *
+   *           - value: Det element som skall läggas till.
+   **********************************************************************************************/
+   bool try_push(const T& value)
+   {
+      const auto tail = m_tail.load(std::memory_order_relaxed);
+      if (tail - m_head.load(std::memory_order_acquire) > m_mask) return false;
+      m_buffer[tail & m_mask] = value;
+      m_tail.store(tail + 1, std::memory_order_release);
+      return true;
+   }
+
+   /**********************************************************************************************
+   * try_pop: Tar bort det första elementet i kön och lagrar det i angiven referens ifall kön 
+   *          inte är tom och returnerar true, annars returneras false. Får enbart anropas av 
+   *          konsumenten.
+   *
+   *          - value: Referens till variabeln som elementet skall lagras i.
+   **********************************************************************************************/
+   bool try_pop(T& value)
+   {
+      const auto head = m_head.load(std::memory_order_relaxed);
+      if (head == m_tail.load(std::memory_order_acquire)) return false;
+      value = m_buffer[head & m_mask];
+      m_head.store(head + 1, std::memory_order_release);
+      return true;
+   }
+};
+
+#endif /* SPSC_QUEUE_HPP_ */
@@ -0,0 +1,161 @@
+/**************************************************************************************************
+* text_parser.cpp: Innehåller funktioner för snabb extrahering av flyttal ur text. Texten läses
+*                  på plats via pekare, exempelvis direkt ur en minnesmappad fil, och flyttal
+*                  typomvandlas via std::from_chars utan att några strängar allokeras.
+**************************************************************************************************/
+#include "text_parser.hpp"
+
+#include <charconv>
+#include <cstring>
+
+/* Statiska funktioner: */
+static inline bool char_is_number(const char c);
+static bool convert_number(const char* begin,
+                           const char* end,
+                           double& number);
+
+/**************************************************************************************************
+* parse_numbers: Extraherar samtliga flyttal ur texten mellan angivna pekare [begin, end) och
+*                lagrar dessa i angiven array values. Flyttal består av siffror, minustecken,
+*                punkt samt kommatecken, där kommatecken tolkas som decimaltecken. Tecken som ej
+*                ingår i ett flyttal fungerar som avgränsare. Tal som inte kan typomvandlas
+*                hoppas över och räknas via referensen num_failures.
+*
+*                Antalet hittade flyttal returneras, även ifall detta överstiger max_values. I
+*                så fall lagras enbart de första max_values talen, vilket gör att anroparen
+*                enkelt kan avgöra ifall en rad innehöll förväntat antal tal.
+*
+*                - begin       : Pekare till textens första tecken.
+*                - end         : Pekare till adressen direkt efter textens sista tecken.
+*                - values      : Array som extraherade flyttal skall lagras i.
+*                - max_values  : Maximalt antal flyttal som får lagras i values.
+*                - num_failures: Räknare som inkrementeras för varje tal som ej kunde
+*                                typomvandlas.
+**************************************************************************************************/
+std::size_t parse_numbers(const char* begin,
+                          const char* end,
+                          double* values,
+                          const std::size_t max_values,
+                          std::size_t& num_failures)
+{
+   std::size_t num_values = 0;
+
+   for (auto i = begin; i < end;)
+   {
+      if (!char_is_number(*i))
+      {
+         ++i;
+         continue;
+      }
+
+      const auto* token_begin = i;
+      while (i < end && char_is_number(*i)) ++i;
+
+      double number;
+
+      if (convert_number(token_begin, i, number))
+      {
+         if (num_values < max_values) values[num_values] = number;
+         num_values++;
+      }
+      else
+      {
+         num_failures++;
+      }
+   }
+   return num_values;
+}
+
+/**************************************************************************************************
+* find_line_end: Returnerar en pekare till nästa radbrytning i texten mellan angivna pekare
+*                [begin, end). Ifall ingen radbrytning hittas returneras end.
+*
+*                - begin: Pekare till det tecken där sökningen skall påbörjas.
+*                - end  : Pekare till adressen direkt efter textens sista tecken.
+**************************************************************************************************/
+const char* find_line_end(const char* begin,
+                          const char* end)
+{
+   const auto* line_end = static_cast<const char*>(
+      std::memchr(begin, '\n', static_cast<std::size_t>(end - begin)));
+   return line_end ? line_end : end;
+}
+
+/**************************************************************************************************
+* next_line: Returnerar en pekare till början av nästa rad givet en pekare till aktuell rads
+*            radbrytning, vilken erhålls via find_line_end. Ifall sista raden saknar avslutande
+*            radbrytning pekar line_end redan på end, varvid end returneras i stället för en
+*            pekare bortom textens slut.
+*
+*            - line_end: Pekare till aktuell rads radbrytning eller till end.
+*            - end     : Pekare till adressen direkt efter textens sista tecken.
+**************************************************************************************************/
+const char* next_line(const char* line_end,
+                      const char* end)
+{
+   return line_end < end ? line_end + 1 : end;
+}
+
+/**************************************************************************************************
+* line_is_blank: Indikerar ifall texten mellan angivna pekare [begin, end) enbart består av
+*                blanksteg, tabbar samt vagnreturer, exempelvis en tom rad i en fil med CRLF.
+*                Samtliga inläsningsfunktioner hoppar över sådana rader utan att räkna dem
+*                som överhoppade rader.
+*
+*                - begin: Pekare till radens första tecken.
+*                - end  : Pekare till adressen direkt efter radens sista tecken.
+**************************************************************************************************/
+bool line_is_blank(const char* begin,
+                   const char* end)
+{
+   for (auto i = begin; i < end; ++i)
+   {
+      if (*i != ' ' && *i != '\t' && *i != '\r') return false;
+   }
+   return true;
+}
+
+/**************************************************************************************************
+* char_is_number: Indikerar ifall givet tecken utgör en siffra eller ett relaterat tecken, såsom
+*                 ett minustecken eller en punkt. Eftersom flyttal ibland matas in både med
+*                 punkt samt kommatecken så utgör båda giltiga tecken.
+*
+*                 - c: Det tecken som skall kontrolleras.
+**************************************************************************************************/
+static inline bool char_is_number(const char c)
+{
+   return (c >= '0' && c <= '9') || c == '-' || c == '.' || c == ',';
+}
+
+/**************************************************************************************************
+* convert_number: Typomvandlar text mellan angivna pekare [begin, end) till ett flyttal via
+*                 std::from_chars. Ifall texten innehåller kommatecken kopieras den först till
+*                 en buffert på stacken, där kommatecken ersätts med punkt. I likhet med
+*                 std::stod accepteras ett giltigt flyttal i början av texten även om
+*                 efterföljande tecken ej kan tolkas. Vid lyckad typomvandling returneras true.
+*
+*                 - begin : Pekare till textens första tecken.
+*                 - end   : Pekare till adressen direkt efter textens sista tecken.
+*                 - number: Referens till det flyttal som resultatet skall lagras i.
+**************************************************************************************************/
+static bool convert_number(const char* begin,
+                           const char* end,
+                           double& number)
+{
+   const auto length = static_cast<std::size_t>(end - begin);
+
+   if (!std::memchr(begin, ',', length))
+   {
+      return std::from_chars(begin, end, number).ec == std::errc{};
+   }
+
+   char buffer[128];
+   if (length > sizeof(buffer)) return false;
+
+   for (std::size_t i = 0; i < length; ++i)
+   {
+      buffer[i] = begin[i] == ',' ? '.' : begin[i];
+   }
+
+   return std::from_chars(buffer, buffer + length, number).ec == std::errc{};
+}
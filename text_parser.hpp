@@ -0,0 +1,24 @@
+/**************************************************************************************************
+* text_parser.hpp: Innehåller funktionalitet för snabb extrahering av flyttal ur text utan
+*                  heapallokering, vilket används vid inläsning av träningsdata.
+**************************************************************************************************/
+#ifndef TEXT_PARSER_HPP_
+#define TEXT_PARSER_HPP_
+
+/* Inkluderingsdirektiv: */
+#include <cstddef>
+
+/* Funktionsdeklarationer: */
+std::size_t parse_numbers(const char* begin,
+                          const char* end,
+                          double* values,
+                          const std::size_t max_values,
+                          std::size_t& num_failures);
+const char* find_line_end(const char* begin,
+                          const char* end);
+const char* next_line(const char* line_end,
+                      const char* end);
+bool line_is_blank(const char* begin,
+                   const char* end);
+
+#endif /* TEXT_PARSER_HPP_ */
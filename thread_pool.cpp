@@ -0,0 +1,138 @@
+/**************************************************************************************************
+* thread_pool.cpp: Innehåller medlemsfunktioner tillhörande klassen thread_pool, vilket används
+*                  för parallell exekvering av deluppgifter.
+**************************************************************************************************/
+#include "thread_pool.hpp"
+
+/**************************************************************************************************
+* thread_pool: Konstruktor för klassen thread_pool, som skapar en trådpool med angivet antal
+*              trådar. Eftersom den anropande tråden deltar i arbetet skapas en arbetstråd 
+*              mindre än angivet antal.
+*
+*              - num_threads: Det totala antalet trådar som skall exekvera deluppgifter.
+**************************************************************************************************/
+thread_pool::thread_pool(const std::size_t num_threads)
+{
+   for (std::size_t i = 1; i < num_threads; ++i)
+   {
+      m_threads.emplace_back(&thread_pool::worker, this);
+   }
+   return;
+}
+
+/**************************************************************************************************
+* ~thread_pool: Destruktor för klassen thread_pool, som signalerar till arbetstrådarna att 
+*               avsluta och väntar tills samtliga trådar har avslutats.
+**************************************************************************************************/
+thread_pool::~thread_pool(void)
+{
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+   }
+
+   m_start.notify_all();
+
+   for (auto& i : m_threads)
+   {
+      i.join();
+   }
+   return;
+}
+
+/**************************************************************************************************
+* worker: Huvudloop för arbetstrådarna. Varje tråd väntar på att en ny omgång deluppgifter 
+*         startas, ansluter till omgången och exekverar deluppgifter tills samtliga har 
+*         påbörjats. Den sista tråden som lämnar omgången signalerar detta till anropande tråd.
+**************************************************************************************************/
+void thread_pool::worker(void)
+{
+   std::size_t generation = 0;
+
+   while (true)
+   {
+      void (*task)(void*, std::size_t);
+      void* context;
+      std::size_t num_tasks;
+
+      {
+         std::unique_lock<std::mutex> lock(m_mutex);
+         m_start.wait(lock, [&] { return m_stop || m_generation != generation; });
+         if (m_stop) return;
+
+         generation = m_generation;
+         task = m_task;
+         context = m_context;
+         num_tasks = m_num_tasks;
+         m_num_active++;
+      }
+
+      execute(task, context, num_tasks);
+
+      {
+         std::lock_guard<std::mutex> lock(m_mutex);
+         if (--m_num_active == 0) m_done.notify_all();
+      }
+   }
+}
+
+/**************************************************************************************************
+* execute: Exekverar deluppgifter i aktuell omgång tills samtliga har påbörjats. Index för nästa 
+*          deluppgift hämtas atomärt, vilket gör att trådarna fördelar arbetet sinsemellan 
+*          utan att låsa någon mutex.
+*
+*          - task     : Funktion som exekverar en deluppgift.
+*          - context  : Argument till funktionen task.
+*          - num_tasks: Antalet deluppgifter i aktuell omgång.
+**************************************************************************************************/
+void thread_pool::execute(void (*task)(void*, std::size_t),
+                          void* context,
+                          const std::size_t num_tasks)
+{
+   for (auto i = m_next_task.fetch_add(1); i < num_tasks; i = m_next_task.fetch_add(1))
+   {
+      task(context, i);
+   }
+   return;
+}
+
+/**************************************************************************************************
+* run_tasks: Startar en ny omgång med angivet antal deluppgifter, deltar i arbetet och väntar 
+*            tills samtliga arbetstrådar har lämnat omgången. Innan en ny omgång startas väntar 
+*            anropande tråd även på eventuella arbetstrådar som anslöt sent till föregående 
+*            omgång, så att dessa inte kan påbörja deluppgifter i den nya omgången.
+*
+*            - num_tasks: Antalet deluppgifter som skall exekveras.
+*            - task     : Funktion som exekverar en deluppgift.
+*            - context  : Argument till funktionen task.
+**************************************************************************************************/
+void thread_pool::run_tasks(const std::size_t num_tasks,
+                            void (*task)(void*, std::size_t),
+                            void* context)
+{
+   if (m_threads.empty() || num_tasks == 1)
+   {
+      for (std::size_t i = 0; i < num_tasks; ++i)
+      {
+         task(context, i);
+      }
+      return;
+   }
+
+   {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_done.wait(lock, [&] { return m_num_active == 0; });
+      m_task = task;
+      m_context = context;
+      m_num_tasks = num_tasks;
+      m_next_task = 0;
+      m_generation++;
+   }
+
+   m_start.notify_all();
+   execute(task, context, num_tasks);
+
+   std::unique_lock<std::mutex> lock(m_mutex);
+   m_done.wait(lock, [&] { return m_num_active == 0; });
+   return;
+}
@@ -0,0 +1,82 @@
+/**************************************************************************************************
+* thread_pool.hpp: Innehåller funktionalitet för parallell exekvering av deluppgifter via
+*                  klassen thread_pool, vilket används för dataparallell träning.
+**************************************************************************************************/
+#ifndef THREAD_POOL_HPP_
+#define THREAD_POOL_HPP_
+
+/* Inkluderingsdirektiv: */
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <type_traits>
+
+/**************************************************************************************************
+* thread_pool: Klass för en trådpool med ett fast antal trådar, där ett givet antal deluppgifter 
+*              kan exekveras parallellt via medlemsfunktionen run. Den anropande tråden deltar i 
+*              arbetet och run returnerar först när samtliga deluppgifter har slutförts. 
+*              Trådarna skapas en gång vid konstruktion och återanvänds därefter, vilket gör att 
+*              run kan anropas upprepade gånger, exempelvis en gång per minibatch, utan att 
+*              trådar eller minne allokeras.
+*
+*              Varje deluppgift identifieras via ett index, vilket gör att resultat kan lagras 
+*              per deluppgift och därefter slås ihop i en fast ordning oavsett vilken tråd som 
+*              exekverade respektive deluppgift.
+*
+*              Klassens kopieringskonstruktor samt tilldelningsoperator är raderade.
+**************************************************************************************************/
+class thread_pool
+{
+protected:
+   /* Medlemmar: */
+   std::vector<std::thread> m_threads;          /* Arbetstrådar (utöver anropande tråd). */
+   std::mutex m_mutex;                          /* Mutex för synkronisering av trådarna. */
+   std::condition_variable m_start;             /* Signalerar att nya deluppgifter finns. */
+   std::condition_variable m_done;              /* Signalerar att arbetstrådar är klara. */
+   void (*m_task)(void*, std::size_t) = nullptr; /* Funktion som exekverar en deluppgift. */
+   void* m_context = nullptr;                   /* Argument till funktionen ovan. */
+   std::size_t m_num_tasks = 0;                 /* Antalet deluppgifter i aktuell omgång. */
+   std::atomic<std::size_t> m_next_task{ 0 };   /* Index för nästa ej påbörjade deluppgift. */
+   std::size_t m_num_active = 0;                /* Antalet arbetstrådar i aktuell omgång. */
+   std::size_t m_generation = 0;                /* Räknare för antalet startade omgångar. */
+   bool m_stop = false;                         /* Indikerar att trådarna skall avslutas. */
+
+   /* Medlemsfunktioner: */
+   void worker(void);
+   void execute(void (*task)(void*, std::size_t),
+                void* context,
+                const std::size_t num_tasks);
+   void run_tasks(const std::size_t num_tasks,
+                  void (*task)(void*, std::size_t),
+                  void* context);
+public:
+   thread_pool(const std::size_t num_threads);
+   ~thread_pool(void);
+   thread_pool(thread_pool&) = delete;
+   thread_pool& operator = (thread_pool&) = delete;
+
+   std::size_t size(void) const { return m_threads.size() + 1; }
+
+   /**********************************************************************************************
+   * run: Exekverar angivet antal deluppgifter parallellt, där angiven funktion task anropas 
+   *      med index för respektive deluppgift [0, num_tasks). Returnerar när samtliga 
+   *      deluppgifter har slutförts.
+   *
+   *      - num_tasks: Antalet deluppgifter som skall exekveras.
+   *      - task     : Funktion eller lambdauttryck som tar index för en deluppgift.
+   **********************************************************************************************/
+   template <typename Task>
+   void run(const std::size_t num_tasks, 
+            Task&& task)
+   {
+      using task_type = std::remove_reference_t<Task>;
+      run_tasks(num_tasks, [](void* context, std::size_t i) 
+                { (*static_cast<task_type*>(context))(i); },
+                const_cast<void*>(static_cast<const void*>(&task)));
+      return;
+   }
+};
+
+#endif /* THREAD_POOL_HPP_ */